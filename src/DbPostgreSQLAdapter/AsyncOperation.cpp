@@ -0,0 +1,258 @@
+#include "stdafx.h"
+#include "AsyncOperation.h"
+
+namespace systelab::db::postgresql {
+
+	AsyncOperation::AsyncOperation(PGconn* connection, ConnectionMutex& connectionMutex,
+								   const std::string& statement, ResultFormat resultFormat,
+								   CompletionCallback onCompleted, FailureCallback onFailed)
+		: m_connection(connection)
+		, m_connectionMutex(connectionMutex)
+		, m_statement(statement)
+		, m_resultFormat(resultFormat)
+		, m_onCompleted(std::move(onCompleted))
+		, m_onFailed(std::move(onFailed))
+		, m_state(State::WAITING)
+		, m_waitingToWrite(false)
+		, m_failureReported(false)
+		, m_copyDrain(CopyDrain::NONE)
+		, m_lastResult(utils::createRAIIPGresult(nullptr))
+	{
+	}
+
+	AsyncOperation::~AsyncOperation() = default;
+
+	PGconn* AsyncOperation::getConnection() const
+	{
+		return m_connection;
+	}
+
+	int AsyncOperation::getSocket() const
+	{
+		return PQsocket(m_connection);
+	}
+
+	AsyncOperation::State AsyncOperation::getState() const
+	{
+		return m_state;
+	}
+
+	bool AsyncOperation::isWaitingToWrite() const
+	{
+		return m_waitingToWrite;
+	}
+
+	void AsyncOperation::tryStart(const void* waiter, const ConnectionMutex::ReleaseCallback& onConnectionReleased)
+	{
+		if (m_state != State::WAITING || !m_connectionMutex.tryLockOrNotifyOnRelease(waiter, onConnectionReleased))
+		{
+			return;
+		}
+
+		m_state = State::RUNNING;
+		PQsetnonblocking(m_connection, 1);
+
+		const int sent = (m_resultFormat == ResultFormat::TEXT) ?
+			PQsendQuery(m_connection, m_statement.c_str()) :
+			PQsendQueryParams(m_connection, m_statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, static_cast<int>(m_resultFormat));
+		if (sent == 0)
+		{
+			failWithConnectionError("Unable to send asynchronous statement: ");
+			return;
+		}
+
+		flush();
+	}
+
+	void AsyncOperation::process()
+	{
+		if (m_state != State::RUNNING)
+		{
+			return;
+		}
+
+		if (m_waitingToWrite)
+		{
+			flush();
+			if (m_state != State::RUNNING)
+			{
+				return;
+			}
+		}
+
+		if (PQconsumeInput(m_connection) == 0)
+		{
+			failWithConnectionError("Unable to read asynchronous result: ");
+			return;
+		}
+
+		if (m_copyDrain != CopyDrain::NONE && !drainAbandonedCopy())
+		{
+			return;
+		}
+
+		// As PQexec does, only the last result is reported when several statements are sent together
+		while (PQisBusy(m_connection) == 0)
+		{
+			PGresult* result = PQgetResult(m_connection);
+			if (!result)
+			{
+				complete();
+				return;
+			}
+
+			m_lastResult = utils::createRAIIPGresult(result);
+
+			// In COPY state PQgetResult keeps returning a new COPY result instead of null
+			const ExecStatusType status = PQresultStatus(result);
+			if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT || status == PGRES_COPY_BOTH)
+			{
+				abandonCopy(status);
+				if (!drainAbandonedCopy())
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	void AsyncOperation::fail(std::exception_ptr error)
+	{
+		if (!m_failureReported)
+		{
+			m_failureReported = true;
+			m_onFailed(error);
+		}
+
+		if (m_state == State::RUNNING)
+		{
+			finish();
+		}
+
+		m_state = State::FINISHED;
+	}
+
+	void AsyncOperation::flush()
+	{
+		const int flushed = PQflush(m_connection);
+		if (flushed < 0)
+		{
+			failWithConnectionError("Unable to send asynchronous statement: ");
+			return;
+		}
+
+		m_waitingToWrite = (flushed == 1);
+	}
+
+	void AsyncOperation::abandonCopy(int copyStatus)
+	{
+		m_failureReported = true;
+		m_onFailed(std::make_exception_ptr(std::runtime_error("COPY statements can't be executed asynchronously, "
+															  "use copyOut or startCopyIn instead")));
+
+		if (copyStatus == PGRES_COPY_OUT)
+		{
+			// The server would otherwise stream the whole copy before it can be discarded
+			PGcancel* cancel = PQgetCancel(m_connection);
+			if (cancel)
+			{
+				char errorBuffer[256];
+				PQcancel(cancel, errorBuffer, sizeof(errorBuffer));
+				PQfreeCancel(cancel);
+			}
+
+			m_copyDrain = CopyDrain::READING_COPY_OUT;
+		}
+		else
+		{
+			m_copyDrain = CopyDrain::ENDING_COPY_IN;
+		}
+	}
+
+	bool AsyncOperation::drainAbandonedCopy()
+	{
+		if (m_copyDrain == CopyDrain::ENDING_COPY_IN)
+		{
+			const int ended = PQputCopyEnd(m_connection, "COPY statements can't be executed asynchronously");
+			if (ended < 0)
+			{
+				failWithConnectionError("Unable to end asynchronous COPY: ");
+				return false;
+			}
+
+			if (ended == 0)
+			{
+				// The end message couldn't be queued yet, so it is sent again once the connection is writable
+				m_waitingToWrite = true;
+				return false;
+			}
+
+			m_copyDrain = (PQresultStatus(m_lastResult.get()) == PGRES_COPY_BOTH) ? CopyDrain::READING_COPY_OUT : CopyDrain::NONE;
+			flush();
+			if (m_state != State::RUNNING)
+			{
+				return false;
+			}
+		}
+
+		if (m_copyDrain == CopyDrain::READING_COPY_OUT)
+		{
+			char* buffer = nullptr;
+			int received = 0;
+			while ((received = PQgetCopyData(m_connection, &buffer, 1)) > 0)
+			{
+				PQfreemem(buffer);
+			}
+
+			if (received == 0)
+			{
+				return false;
+			}
+
+			if (received == -2)
+			{
+				failWithConnectionError("Unable to read asynchronous COPY: ");
+				return false;
+			}
+
+			m_copyDrain = CopyDrain::NONE;
+		}
+
+		return true;
+	}
+
+	void AsyncOperation::complete()
+	{
+		if (m_failureReported)
+		{
+			// The failure was reported when the statement turned out to be a COPY, so the remaining results are discarded
+			finish();
+			m_state = State::FINISHED;
+			return;
+		}
+
+		try
+		{
+			m_onCompleted(m_lastResult.get());
+		}
+		catch (...)
+		{
+			m_onFailed(std::current_exception());
+		}
+
+		finish();
+		m_state = State::FINISHED;
+	}
+
+	void AsyncOperation::failWithConnectionError(const std::string& message)
+	{
+		fail(std::make_exception_ptr(std::runtime_error(message + PQerrorMessage(m_connection))));
+	}
+
+	void AsyncOperation::finish()
+	{
+		m_lastResult.reset();
+		PQsetnonblocking(m_connection, 0);
+		m_connectionMutex.unlock();
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ConnectionMutex.h"
+#include "PostgresUtils.h"
+#include "ResultFormat.h"
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db::postgresql {
+
+	// Statement executed by an AsyncReactor. It is only sent once the reactor thread acquires the connection
+	// lock, and its callbacks are invoked from that thread before the lock is released.
+	class AsyncOperation
+	{
+	public:
+		typedef std::function<void(const PGresult*)> CompletionCallback;
+		typedef std::function<void(std::exception_ptr)> FailureCallback;
+
+		enum class State
+		{
+			WAITING = 0,
+			RUNNING = 1,
+			FINISHED = 2
+		};
+
+		AsyncOperation(PGconn* connection, ConnectionMutex& connectionMutex,
+					   const std::string& statement, ResultFormat resultFormat,
+					   CompletionCallback onCompleted, FailureCallback onFailed);
+		~AsyncOperation();
+
+		PGconn* getConnection() const;
+		int getSocket() const;
+		State getState() const;
+		bool isWaitingToWrite() const;
+
+		// When the connection is locked, the callback is invoked once it is released so the start can be retried
+		void tryStart(const void* waiter, const ConnectionMutex::ReleaseCallback& onConnectionReleased);
+		void process();
+		void fail(std::exception_ptr error);
+
+	private:
+		// COPY statements aren't supported asynchronously: the failure is reported at once and the copy is ended
+		// or cancelled, but the connection stays locked until its remaining results have been read
+		enum class CopyDrain
+		{
+			NONE = 0,
+			ENDING_COPY_IN = 1,
+			READING_COPY_OUT = 2
+		};
+
+		PGconn* m_connection;
+		ConnectionMutex& m_connectionMutex;
+		std::string m_statement;
+		ResultFormat m_resultFormat;
+		CompletionCallback m_onCompleted;
+		FailureCallback m_onFailed;
+		State m_state;
+		bool m_waitingToWrite;
+		bool m_failureReported;
+		CopyDrain m_copyDrain;
+		utils::PGResultRAII m_lastResult;
+
+		void flush();
+		void abandonCopy(int copyStatus);
+		bool drainAbandonedCopy();
+		void complete();
+		void failWithConnectionError(const std::string& message);
+		void finish();
+	};
+}
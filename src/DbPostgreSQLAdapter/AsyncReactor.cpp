@@ -0,0 +1,233 @@
+#include "stdafx.h"
+#include "AsyncReactor.h"
+
+#include "AsyncOperation.h"
+
+namespace systelab::db::postgresql {
+
+	namespace {
+#ifdef _WIN32
+		// WSAPoll can't wait on a pipe, so new submissions and released connections are picked up periodically
+		const int IDLE_POLL_MILLISECONDS = 10;
+
+		int pollSockets(std::vector<pollfd>& sockets, int timeout)
+		{
+			if (sockets.empty())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+				return 0;
+			}
+
+			return WSAPoll(sockets.data(), static_cast<ULONG>(sockets.size()), timeout);
+		}
+#else
+		const int IDLE_POLL_MILLISECONDS = -1;
+
+		int pollSockets(std::vector<pollfd>& sockets, int timeout)
+		{
+			return poll(sockets.data(), static_cast<nfds_t>(sockets.size()), timeout);
+		}
+#endif
+	}
+
+	// Shared with the callbacks left on locked connections, so a connection released once the reactor is
+	// destroyed doesn't write to a closed pipe
+	class AsyncReactor::WakeUpPipe
+	{
+	public:
+		WakeUpPipe()
+			: m_descriptors{ -1, -1 }
+		{
+#ifndef _WIN32
+			if (pipe(m_descriptors.data()) != 0)
+			{
+				throw std::runtime_error("Unable to create the asynchronous reactor wake up pipe");
+			}
+#endif
+		}
+
+		~WakeUpPipe()
+		{
+#ifndef _WIN32
+			close(m_descriptors[0]);
+			close(m_descriptors[1]);
+#endif
+		}
+
+		int getReadDescriptor() const
+		{
+			return m_descriptors[0];
+		}
+
+		void signal() const
+		{
+#ifndef _WIN32
+			const char wakeUpSignal = 0;
+			[[maybe_unused]] const auto bytesWritten = write(m_descriptors[1], &wakeUpSignal, 1);
+#endif
+		}
+
+		void drain() const
+		{
+#ifndef _WIN32
+			char wakeUpBuffer[64];
+			[[maybe_unused]] const auto bytesRead = read(m_descriptors[0], wakeUpBuffer, sizeof(wakeUpBuffer));
+#endif
+		}
+
+	private:
+		std::array<int, 2> m_descriptors;
+	};
+
+	AsyncReactor::AsyncReactor()
+		: m_stopping(false)
+		, m_wakeUpPipe(std::make_shared<WakeUpPipe>())
+	{
+		m_thread = std::thread(&AsyncReactor::run, this);
+	}
+
+	AsyncReactor::~AsyncReactor()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		wakeUp();
+		m_thread.join();
+	}
+
+	void AsyncReactor::submit(std::unique_ptr<AsyncOperation> operation)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_submittedOperations.push_back(std::move(operation));
+		}
+
+		wakeUp();
+	}
+
+	void AsyncReactor::run()
+	{
+		std::vector<std::unique_ptr<AsyncOperation>> waitingOperations;
+		std::vector<std::unique_ptr<AsyncOperation>> runningOperations;
+		while (true)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::ranges::move(m_submittedOperations, std::back_inserter(waitingOperations));
+				m_submittedOperations.clear();
+
+				// Operations already sent are completed, the ones still waiting are cancelled
+				if (m_stopping)
+				{
+					for (auto& waitingOperation : waitingOperations)
+					{
+						waitingOperation->fail(std::make_exception_ptr(std::runtime_error("Asynchronous operation cancelled")));
+					}
+					waitingOperations.clear();
+
+					if (runningOperations.empty())
+					{
+						return;
+					}
+				}
+			}
+
+			startWaitingOperations(waitingOperations, runningOperations);
+			std::erase_if(runningOperations,
+				[](const std::unique_ptr<AsyncOperation>& operation)
+				{
+					return operation->getState() == AsyncOperation::State::FINISHED;
+				});
+
+			processReadyOperations(runningOperations);
+			std::erase_if(runningOperations,
+				[](const std::unique_ptr<AsyncOperation>& operation)
+				{
+					return operation->getState() == AsyncOperation::State::FINISHED;
+				});
+		}
+	}
+
+	void AsyncReactor::startWaitingOperations(std::vector<std::unique_ptr<AsyncOperation>>& waitingOperations,
+											  std::vector<std::unique_ptr<AsyncOperation>>& runningOperations) const
+	{
+		const std::weak_ptr<WakeUpPipe> wakeUpPipe = m_wakeUpPipe;
+		const auto onConnectionReleased = [wakeUpPipe]()
+		{
+			if (const auto pipe = wakeUpPipe.lock())
+			{
+				pipe->signal();
+			}
+		};
+
+		// Operations on the same connection are started in submission order, one at a time
+		std::set<PGconn*> busyConnections;
+		for (const auto& runningOperation : runningOperations)
+		{
+			busyConnections.insert(runningOperation->getConnection());
+		}
+
+		auto operationIterator = waitingOperations.begin();
+		while (operationIterator != waitingOperations.end())
+		{
+			AsyncOperation& operation = **operationIterator;
+			if (!busyConnections.insert(operation.getConnection()).second)
+			{
+				++operationIterator;
+				continue;
+			}
+
+			operation.tryStart(this, onConnectionReleased);
+			if (operation.getState() == AsyncOperation::State::WAITING)
+			{
+				++operationIterator;
+				continue;
+			}
+
+			runningOperations.push_back(std::move(*operationIterator));
+			operationIterator = waitingOperations.erase(operationIterator);
+		}
+	}
+
+	void AsyncReactor::processReadyOperations(std::vector<std::unique_ptr<AsyncOperation>>& runningOperations)
+	{
+		std::vector<pollfd> sockets;
+#ifndef _WIN32
+		sockets.push_back({ m_wakeUpPipe->getReadDescriptor(), POLLIN, 0 });
+#endif
+		for (const auto& runningOperation : runningOperations)
+		{
+			pollfd socket{};
+			socket.fd = static_cast<decltype(socket.fd)>(runningOperation->getSocket());
+			socket.events = static_cast<short>(POLLIN | (runningOperation->isWaitingToWrite() ? POLLOUT : 0));
+			sockets.push_back(socket);
+		}
+
+		if (pollSockets(sockets, IDLE_POLL_MILLISECONDS) <= 0)
+		{
+			return;
+		}
+
+		const std::size_t firstOperationSocket = sockets.size() - runningOperations.size();
+#ifndef _WIN32
+		if (sockets[0].revents != 0)
+		{
+			m_wakeUpPipe->drain();
+		}
+#endif
+		for (std::size_t i = 0; i < runningOperations.size(); i++)
+		{
+			if (sockets[firstOperationSocket + i].revents != 0)
+			{
+				runningOperations[i]->process();
+			}
+		}
+	}
+
+	void AsyncReactor::wakeUp()
+	{
+		m_wakeUpPipe->signal();
+	}
+}
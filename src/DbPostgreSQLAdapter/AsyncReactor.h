@@ -0,0 +1,31 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+	class AsyncOperation;
+
+	// Runs a single thread that sends the asynchronous statements of any number of connections and
+	// waits for their results. Databases must outlive the operations they submit to the reactor.
+	class AsyncReactor
+	{
+	public:
+		AsyncReactor();
+		~AsyncReactor();
+
+		void submit(std::unique_ptr<AsyncOperation> operation);
+
+	private:
+		class WakeUpPipe;
+
+		std::mutex m_mutex;
+		std::vector<std::unique_ptr<AsyncOperation>> m_submittedOperations;
+		bool m_stopping;
+		std::shared_ptr<WakeUpPipe> m_wakeUpPipe;
+		std::thread m_thread;
+
+		void run();
+		void startWaitingOperations(std::vector<std::unique_ptr<AsyncOperation>>& waitingOperations,
+									std::vector<std::unique_ptr<AsyncOperation>>& runningOperations) const;
+		void processReadyOperations(std::vector<std::unique_ptr<AsyncOperation>>& runningOperations);
+		void wakeUp();
+	};
+}
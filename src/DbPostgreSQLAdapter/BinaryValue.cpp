@@ -1,24 +1,70 @@
 #include "stdafx.h"
 #include "BinaryValue.h"
 
-#include <streambuf>
+namespace systelab::db::postgresql {
 
-
-namespace systelab { namespace db { namespace postgresql {
+	BinaryValue::BinaryValue()
+		: m_buffer(std::ios::in | std::ios::out)
+	{
+	}
 
 	BinaryValue::BinaryValue(std::istream& inputStream)
+		: BinaryValue()
 	{
+		std::ostream(&m_buffer) << inputStream.rdbuf();
+	}
 
+	BinaryValue::BinaryValue(std::string&& data)
+		: m_buffer(std::move(data), std::ios::in | std::ios::out)
+	{
+	}
+
+	BinaryValue::BinaryValue(std::string_view data)
+		: BinaryValue(std::string(data))
+	{
 	}
 
 	std::ostream BinaryValue::getOutputStream() const
 	{
-		throw("Not implemented");
+		m_buffer.pubseekoff(0, std::ios::end, std::ios::out);
+		return std::ostream(&m_buffer);
 	}
 
 	std::istream BinaryValue::getInputStream() const
 	{
-		throw("Not implemented");
+		m_buffer.pubseekpos(0, std::ios::in);
+		return std::istream(&m_buffer);
 	}
 
-}}}
\ No newline at end of file
+	std::string_view BinaryValue::getData() const
+	{
+		return m_buffer.view();
+	}
+
+	std::unique_ptr<BinaryValue> BinaryValue::copy(const IBinaryValue& value)
+	{
+		const auto* binaryValue = dynamic_cast<const BinaryValue*>(&value);
+		if (binaryValue)
+		{
+			return std::make_unique<BinaryValue>(binaryValue->getData());
+		}
+
+		std::istream inputStream = value.getInputStream();
+		return std::make_unique<BinaryValue>(inputStream);
+	}
+
+	namespace utils {
+		std::string_view getBinaryData(const IBinaryValue& value, std::string& buffer)
+		{
+			const auto* binaryValue = dynamic_cast<const BinaryValue*>(&value);
+			if (binaryValue)
+			{
+				return binaryValue->getData();
+			}
+
+			std::istream inputStream = value.getInputStream();
+			buffer.assign(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+			return std::string_view(buffer);
+		}
+	}
+}
@@ -2,18 +2,33 @@
 
 #include "DbAdapterInterface/IBinaryValue.h"
 
-namespace systelab { namespace db { namespace postgresql {
+namespace systelab::db::postgresql {
 
+	// Owns the bytes of a bytea value. Streams returned by the getters share the same buffer: input streams
+	// read it from the start and output streams append to it
 	class BinaryValue : public IBinaryValue
 	{
 	public:
+		BinaryValue();
 		BinaryValue(std::istream& inputStream);
+		BinaryValue(std::string&& data);
+		BinaryValue(std::string_view data);
 		~BinaryValue() override = default;
 
 		std::ostream getOutputStream() const override;
 		std::istream getInputStream() const override;
 
+		// Valid until the value is written again
+		std::string_view getData() const;
+
+		static std::unique_ptr<BinaryValue> copy(const IBinaryValue& value);
+
 	private:
-		std::ostringstream m_buffer;
+		mutable std::stringbuf m_buffer;
 	};
-}}}
\ No newline at end of file
+
+	namespace utils {
+		// Bytes of a binary value, read into the buffer when the value isn't one of the adapter's own
+		std::string_view getBinaryData(const IBinaryValue& value, std::string& buffer);
+	}
+}
@@ -0,0 +1,56 @@
+#include "stdafx.h"
+#include "BusyConnectionLock.h"
+
+namespace systelab::db::postgresql {
+
+	void ConnectionState::checkAvailable() const
+	{
+		if (broken)
+		{
+			throw std::runtime_error("The connection was left in an unusable state and must be discarded");
+		}
+
+		if (busy)
+		{
+			throw std::runtime_error("The connection is in use by an open stream, COPY, pipeline or large object");
+		}
+	}
+
+	BusyConnectionLock::BusyConnectionLock(ConnectionMutex& mutex, ConnectionState& state)
+		: m_lock(mutex)
+		, m_state(&state)
+	{
+		m_state->checkAvailable();
+		m_state->busy = true;
+	}
+
+	BusyConnectionLock::BusyConnectionLock(BusyConnectionLock&& other) noexcept
+		: m_lock(std::move(other.m_lock))
+		, m_state(other.m_state)
+	{
+	}
+
+	BusyConnectionLock::~BusyConnectionLock()
+	{
+		unlock();
+	}
+
+	bool BusyConnectionLock::ownsLock() const
+	{
+		return m_lock.owns_lock();
+	}
+
+	void BusyConnectionLock::markConnectionBroken()
+	{
+		m_state->broken = true;
+	}
+
+	void BusyConnectionLock::unlock()
+	{
+		if (m_lock.owns_lock())
+		{
+			m_state->busy = false;
+			m_lock.unlock();
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ConnectionMutex.h"
+
+namespace systelab::db::postgresql {
+
+	// State of a connection shared with the objects that take it over. Only accessed with the connection locked
+	struct ConnectionState
+	{
+		bool busy = false;
+		// Set when the protocol state of the connection couldn't be restored, so it must be discarded
+		bool broken = false;
+
+		// Throws std::runtime_error while the connection is busy or once it is broken
+		void checkAvailable() const;
+	};
+
+	// Keeps the connection locked and flagged as busy while a stream, COPY, pipeline or large object uses it.
+	// The connection mutex is recursive, so the flag is what makes the statements issued meanwhile by the
+	// owning thread fail instead of interleaving with the ongoing protocol.
+	// It must be released on the thread that acquired it.
+	class BusyConnectionLock
+	{
+	public:
+		BusyConnectionLock(ConnectionMutex& mutex, ConnectionState& state);
+		BusyConnectionLock(BusyConnectionLock&& other) noexcept;
+		BusyConnectionLock& operator=(BusyConnectionLock&&) = delete;
+		~BusyConnectionLock();
+
+		bool ownsLock() const;
+		void markConnectionBroken();
+		void unlock();
+
+	private:
+		std::unique_lock<ConnectionMutex> m_lock;
+		ConnectionState* m_state;
+	};
+}
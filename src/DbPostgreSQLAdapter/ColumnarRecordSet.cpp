@@ -0,0 +1,224 @@
+#include "stdafx.h"
+#include "ColumnarRecordSet.h"
+
+#include "BinaryValue.h"
+#include "DefaultOID.h"
+#include "FieldValue.h"
+#include "Record.h"
+#include "ResultDecoder.h"
+#include "ResultFields.h"
+#include "ResultFieldsCache.h"
+
+#include "DbAdapterInterface/IFieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	namespace {
+		const unsigned int NULL_BITMAP_WORD_BITS = 64;
+
+		template<typename T, typename Decoder>
+		std::unique_ptr<T[]> decodeColumnValues(const PGresult* statementResult, int columnIndex,
+												std::vector<std::uint64_t>& nullBitmap, Decoder decoder)
+		{
+			const int rowsCount = PQntuples(statementResult);
+			auto values = std::make_unique<T[]>(rowsCount);
+			for (int i = 0; i < rowsCount; i++)
+			{
+				if (PQgetisnull(statementResult, i, columnIndex) == 1)
+				{
+					nullBitmap[i / NULL_BITMAP_WORD_BITS] |= (std::uint64_t{ 1 } << (i % NULL_BITMAP_WORD_BITS));
+				}
+				else
+				{
+					values[i] = decoder(statementResult, i, columnIndex);
+				}
+			}
+
+			return values;
+		}
+	}
+
+	ColumnarRecordSet::ColumnarRecordSet(const PGresult* statementResult)
+		: m_recordsCount(static_cast<unsigned int>(PQntuples(statementResult)))
+		, m_currentRecordIndex(0)
+	{
+		m_resultFields = ResultFieldsCache::getInstance().getResultFields(statementResult);
+		m_fieldNameIndex = m_resultFields->getFieldNameIndex();
+
+		// Wire sizes only give the initial arena size: binary uuid and time values decode to longer text,
+		// so the arena grows in new blocks and the string views handed out never move
+		std::size_t stringArenaSize = 0;
+		const unsigned int fieldsCount = m_resultFields->getFieldsCount();
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			const FieldTypes fieldType = m_resultFields->getField(i).getType();
+			if (fieldType == STRING || fieldType == BINARY)
+			{
+				for (unsigned int j = 0; j < m_recordsCount; j++)
+				{
+					stringArenaSize += static_cast<std::size_t>(PQgetlength(statementResult, j, i));
+				}
+			}
+		}
+
+		m_stringArena = std::make_unique<std::pmr::monotonic_buffer_resource>(std::max<std::size_t>(stringArenaSize, 1));
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			loadColumn(statementResult, i);
+		}
+
+		loadCurrentRecord();
+	}
+
+	ColumnarRecordSet::~ColumnarRecordSet() = default;
+
+	unsigned int ColumnarRecordSet::getFieldsCount() const
+	{
+		return m_resultFields->getFieldsCount();
+	}
+
+	const IField& ColumnarRecordSet::getField(unsigned int index) const
+	{
+		return m_resultFields->getField(index);
+	}
+
+	const IField& ColumnarRecordSet::getField(const std::string& fieldName) const
+	{
+		return m_resultFields->getField(fieldName);
+	}
+
+	unsigned int ColumnarRecordSet::getRecordsCount() const
+	{
+		return m_recordsCount;
+	}
+
+	const IRecord& ColumnarRecordSet::getCurrentRecord() const
+	{
+		return *m_currentRecord;
+	}
+
+	std::unique_ptr<IRecord> ColumnarRecordSet::copyCurrentRecord() const
+	{
+		std::vector<std::unique_ptr<IFieldValue>> copiedFieldValues;
+		const unsigned int fieldsCount = m_resultFields->getFieldsCount();
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			copiedFieldValues.push_back(createFieldValue(i, m_currentRecordIndex));
+		}
+
+		return std::make_unique<Record>(copiedFieldValues, m_fieldNameIndex);
+	}
+
+	bool ColumnarRecordSet::isCurrentRecordValid() const
+	{
+		return (m_currentRecordIndex < m_recordsCount);
+	}
+
+	void ColumnarRecordSet::nextRecord()
+	{
+		m_currentRecordIndex++;
+		loadCurrentRecord();
+	}
+
+	bool ColumnarRecordSet::isNull(unsigned int columnIndex, unsigned int recordIndex) const
+	{
+		if (recordIndex >= m_recordsCount)
+		{
+			throw std::out_of_range("The requested record doesn't exist");
+		}
+
+		const std::uint64_t nullBitmapWord = m_columns.at(columnIndex).nullBitmap[recordIndex / NULL_BITMAP_WORD_BITS];
+		return ((nullBitmapWord >> (recordIndex % NULL_BITMAP_WORD_BITS)) & 1) != 0;
+	}
+
+	void ColumnarRecordSet::loadColumn(const PGresult* statementResult, unsigned int columnIndex)
+	{
+		Column column;
+		column.nullBitmap.resize((m_recordsCount + NULL_BITMAP_WORD_BITS - 1) / NULL_BITMAP_WORD_BITS);
+
+		const int resultColumnIndex = static_cast<int>(columnIndex);
+		const FieldTypes fieldType = m_resultFields->getField(columnIndex).getType();
+		switch (fieldType)
+		{
+			case BOOLEAN:
+				column.values = decodeColumnValues<bool>(statementResult, resultColumnIndex, column.nullBitmap, utils::decodeBooleanValue);
+				break;
+			case INT:
+				if (static_cast<PostgresqlOID>(PQftype(statementResult, resultColumnIndex)) == PostgresqlOID::bigIntOID)
+				{
+					column.values = decodeColumnValues<std::int64_t>(statementResult, resultColumnIndex, column.nullBitmap, utils::decodeBigIntValue);
+				}
+				else
+				{
+					column.values = decodeColumnValues<int>(statementResult, resultColumnIndex, column.nullBitmap, utils::decodeIntValue);
+				}
+				break;
+			case DOUBLE:
+				column.values = decodeColumnValues<double>(statementResult, resultColumnIndex, column.nullBitmap, utils::decodeDoubleValue);
+				break;
+			case STRING:
+			case BINARY:
+			{
+				const auto decoder = (fieldType == STRING) ? utils::decodeStringValue : utils::decodeBinaryData;
+				column.values = decodeColumnValues<std::string_view>(statementResult, resultColumnIndex, column.nullBitmap,
+					[this, decoder](const PGresult* result, int rowIndex, int columnIndex)
+					{
+						const std::string_view value = decoder(result, rowIndex, columnIndex);
+						if (value.empty())
+						{
+							return std::string_view();
+						}
+
+						char* storedValue = static_cast<char*>(m_stringArena->allocate(value.size(), alignof(char)));
+						std::copy(value.begin(), value.end(), storedValue);
+						return std::string_view(storedValue, value.size());
+					});
+			}
+			break;
+			case DATETIME:
+				column.values = decodeColumnValues<std::chrono::system_clock::time_point>(statementResult, resultColumnIndex,
+																						   column.nullBitmap, utils::decodeDateTimeValue);
+				break;
+			default:
+				throw std::runtime_error("Unknown field type.");
+		}
+
+		m_columns.push_back(std::move(column));
+	}
+
+	std::unique_ptr<IFieldValue> ColumnarRecordSet::createFieldValue(unsigned int columnIndex, unsigned int recordIndex) const
+	{
+		const IField& field = m_resultFields->getField(columnIndex);
+		if (isNull(columnIndex, recordIndex))
+		{
+			return std::make_unique<FieldValue>(field);
+		}
+
+		return std::visit([&field, recordIndex](const auto& values) -> std::unique_ptr<IFieldValue>
+			{
+				const auto& value = values[recordIndex];
+				if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, std::string_view>)
+				{
+					if (field.getType() == BINARY)
+					{
+						return std::make_unique<FieldValue>(field, std::make_unique<BinaryValue>(value));
+					}
+
+					return std::make_unique<FieldValue>(field, std::string(value));
+				}
+				else
+				{
+					return std::make_unique<FieldValue>(field, value);
+				}
+			}, m_columns.at(columnIndex).values);
+	}
+
+	void ColumnarRecordSet::loadCurrentRecord()
+	{
+		m_currentRecord.reset();
+		if (isCurrentRecordValid())
+		{
+			m_currentRecord = copyCurrentRecord();
+		}
+	}
+}
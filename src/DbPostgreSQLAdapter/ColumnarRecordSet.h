@@ -0,0 +1,81 @@
+#pragma once
+
+#include "DbAdapterInterface/IRecordSet.h"
+
+#include "FieldNameIndex.h"
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db {
+	class IField;
+	class IFieldValue;
+	class IRecord;
+}
+
+namespace systelab::db::postgresql {
+
+	class ResultFields;
+
+	// Stores each result column in a typed contiguous array, with a null bitmap per column and
+	// all text and bytea values copied into a growing arena. Records are only built for the cursor position.
+	class ColumnarRecordSet : public IRecordSet
+	{
+	public:
+		ColumnarRecordSet(const PGresult* statementResult);
+		~ColumnarRecordSet() override;
+
+		unsigned int getFieldsCount() const override;
+		const IField& getField(unsigned int index) const override;
+		const IField& getField(const std::string& fieldName) const override;
+
+		unsigned int getRecordsCount() const override;
+
+		const IRecord& getCurrentRecord() const override;
+		std::unique_ptr<IRecord> copyCurrentRecord() const override;
+		bool isCurrentRecordValid() const override;
+		void nextRecord() override;
+
+		// Values of null cells are default constructed, check them with isNull. Integer columns are
+		// stored as int, except bigint columns that are stored as std::int64_t. Text and bytea columns
+		// are stored as std::string_view into the arena
+		template<typename T>
+		std::span<const T> column(unsigned int index) const
+		{
+			const auto* values = std::get_if<std::unique_ptr<T[]>>(&m_columns.at(index).values);
+			if (values == nullptr)
+			{
+				throw std::runtime_error("The requested column type doesn't match the field type");
+			}
+
+			return std::span<const T>(values->get(), m_recordsCount);
+		}
+
+		bool isNull(unsigned int columnIndex, unsigned int recordIndex) const;
+
+	private:
+		typedef std::variant<std::unique_ptr<bool[]>,
+							 std::unique_ptr<int[]>,
+							 std::unique_ptr<std::int64_t[]>,
+							 std::unique_ptr<double[]>,
+							 std::unique_ptr<std::string_view[]>,
+							 std::unique_ptr<std::chrono::system_clock::time_point[]>> ColumnValues;
+
+		struct Column
+		{
+			ColumnValues values;
+			std::vector<std::uint64_t> nullBitmap;
+		};
+
+		std::shared_ptr<const ResultFields> m_resultFields;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::vector<Column> m_columns;
+		std::unique_ptr<std::pmr::monotonic_buffer_resource> m_stringArena;
+		unsigned int m_recordsCount;
+		unsigned int m_currentRecordIndex;
+		std::unique_ptr<IRecord> m_currentRecord;
+
+		void loadColumn(const PGresult* statementResult, unsigned int columnIndex);
+		std::unique_ptr<IFieldValue> createFieldValue(unsigned int columnIndex, unsigned int recordIndex) const;
+		void loadCurrentRecord();
+	};
+}
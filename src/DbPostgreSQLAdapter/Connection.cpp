@@ -8,6 +8,11 @@
 namespace systelab::db::postgresql {
 
 	std::unique_ptr<IDatabase> Connection::loadDatabase(IConnectionConfiguration& configuration)
+	{
+		return openDatabase(configuration);
+	}
+
+	std::unique_ptr<Database> Connection::openDatabase(IConnectionConfiguration& configuration)
 	{
 		PGconn* connection;
 		const std::string host = configuration.getParameter("host");
@@ -24,6 +29,7 @@ namespace systelab::db::postgresql {
 		if (PQstatus(connection) != CONNECTION_OK)
 		{
 			const std::string extendedMessage = PQerrorMessage(connection);
+			PQfinish(connection);
 			throw PostgreSQLException("Unable to connect to database '" + (dbName ? *dbName : "") + "'", extendedMessage);
 		}
 
@@ -32,6 +38,7 @@ namespace systelab::db::postgresql {
 		if (PQresultStatus(result.get()) != PGRES_TUPLES_OK)
 		{
 			const std::string extendedMessage = PQerrorMessage(connection);
+			PQfinish(connection);
 			throw PostgreSQLException("Unable to connect to database '" + (dbName ? *dbName : "") + "'", extendedMessage);
 		}
 	
@@ -9,6 +9,7 @@ namespace systelab {
 }
 
 namespace systelab { namespace db { namespace postgresql {
+	class Database;
 
 	class Connection : public IConnection
 	{
@@ -17,6 +18,7 @@ namespace systelab { namespace db { namespace postgresql {
 		~Connection() override = default;
 
 		std::unique_ptr<IDatabase> loadDatabase(IConnectionConfiguration&) override;
+		std::unique_ptr<Database> openDatabase(IConnectionConfiguration&);
 
 	public:
 		struct PostgreSQLException : public Exception
@@ -0,0 +1,64 @@
+#include "stdafx.h"
+#include "ConnectionMutex.h"
+
+namespace systelab::db::postgresql {
+
+	ConnectionMutex::ConnectionMutex()
+		: m_lockCount(0)
+	{
+	}
+
+	ConnectionMutex::~ConnectionMutex() = default;
+
+	void ConnectionMutex::lock()
+	{
+		m_mutex.lock();
+		m_lockCount++;
+	}
+
+	bool ConnectionMutex::try_lock()
+	{
+		if (!m_mutex.try_lock())
+		{
+			return false;
+		}
+
+		m_lockCount++;
+		return true;
+	}
+
+	void ConnectionMutex::unlock()
+	{
+		if (--m_lockCount > 0)
+		{
+			m_mutex.unlock();
+			return;
+		}
+
+		// Released while holding the callbacks lock, so a waiter can't register after the callbacks are taken
+		// but before the mutex is available
+		std::map<const void*, ReleaseCallback> releaseCallbacks;
+		{
+			std::lock_guard<std::mutex> lock(m_releaseCallbacksMutex);
+			releaseCallbacks.swap(m_releaseCallbacks);
+			m_mutex.unlock();
+		}
+
+		for (const auto& [waiter, onReleased] : releaseCallbacks)
+		{
+			onReleased();
+		}
+	}
+
+	bool ConnectionMutex::tryLockOrNotifyOnRelease(const void* waiter, const ReleaseCallback& onReleased)
+	{
+		std::lock_guard<std::mutex> lock(m_releaseCallbacksMutex);
+		if (try_lock())
+		{
+			return true;
+		}
+
+		m_releaseCallbacks.insert_or_assign(waiter, onReleased);
+		return false;
+	}
+}
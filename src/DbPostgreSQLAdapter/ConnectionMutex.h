@@ -0,0 +1,30 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+
+	// Recursive mutex that serializes the use of a connection. An asynchronous reactor that finds it locked
+	// leaves a callback to be woken up once the owning thread fully releases it, instead of polling it
+	class ConnectionMutex
+	{
+	public:
+		typedef std::function<void()> ReleaseCallback;
+
+		ConnectionMutex();
+		~ConnectionMutex();
+
+		void lock();
+		bool try_lock();
+		void unlock();
+
+		// When the mutex can't be locked, the callback is invoked by the thread that releases it. A single
+		// callback is kept for each waiter, until the next release
+		bool tryLockOrNotifyOnRelease(const void* waiter, const ReleaseCallback& onReleased);
+
+	private:
+		std::recursive_mutex m_mutex;
+		// Only accessed by the thread that owns the mutex
+		unsigned int m_lockCount;
+		std::mutex m_releaseCallbacksMutex;
+		std::map<const void*, ReleaseCallback> m_releaseCallbacks;
+	};
+}
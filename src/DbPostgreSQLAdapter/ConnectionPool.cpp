@@ -0,0 +1,260 @@
+#include "stdafx.h"
+#include "ConnectionPool.h"
+
+#include "Connection.h"
+#include "Database.h"
+
+namespace systelab::db::postgresql {
+
+	namespace {
+		const std::chrono::microseconds LATENCY_BUCKETS_UPPER_BOUNDS[] = {
+			std::chrono::microseconds(100),
+			std::chrono::milliseconds(1),
+			std::chrono::milliseconds(10),
+			std::chrono::milliseconds(100),
+			std::chrono::seconds(1),
+			std::chrono::seconds(10),
+			std::chrono::microseconds::max()
+		};
+	}
+
+	ConnectionPool::Lease::Lease(ConnectionPool& pool, std::unique_ptr<Database> database)
+		: m_pool(&pool)
+		, m_database(std::move(database))
+	{
+	}
+
+	ConnectionPool::Lease::Lease(Lease&& other) noexcept
+		: m_pool(other.m_pool)
+		, m_database(std::move(other.m_database))
+	{
+	}
+
+	ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			m_pool = other.m_pool;
+			m_database = std::move(other.m_database);
+		}
+
+		return *this;
+	}
+
+	ConnectionPool::Lease::~Lease()
+	{
+		release();
+	}
+
+	Database& ConnectionPool::Lease::get() const
+	{
+		return *m_database;
+	}
+
+	Database& ConnectionPool::Lease::operator*() const
+	{
+		return *m_database;
+	}
+
+	Database* ConnectionPool::Lease::operator->() const
+	{
+		return m_database.get();
+	}
+
+	void ConnectionPool::Lease::release()
+	{
+		if (m_database)
+		{
+			m_pool->release(std::move(m_database));
+		}
+	}
+
+	ConnectionPool::ConnectionPool(IConnectionConfiguration& connectionConfiguration, const ConnectionPoolConfiguration& poolConfiguration)
+		: m_connectionConfiguration(connectionConfiguration)
+		, m_poolConfiguration(poolConfiguration)
+	{
+		if (m_poolConfiguration.maxSize == 0 || m_poolConfiguration.minSize > m_poolConfiguration.maxSize)
+		{
+			throw std::invalid_argument("Invalid connection pool size limits");
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < m_poolConfiguration.minSize; i++)
+		{
+			m_idleConnections.push_back({ Connection().openDatabase(m_connectionConfiguration), now });
+			m_totalConnections++;
+		}
+	}
+
+	ConnectionPool::~ConnectionPool() = default;
+
+	ConnectionPool::Lease ConnectionPool::acquire()
+	{
+		return acquire(m_poolConfiguration.checkoutTimeout);
+	}
+
+	ConnectionPool::Lease ConnectionPool::acquire(std::chrono::milliseconds timeout)
+	{
+		const auto requestTime = std::chrono::steady_clock::now();
+		const auto deadline = requestTime + timeout;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_waitingRequests++;
+		m_maxWaitingRequests = std::max(m_maxWaitingRequests, m_waitingRequests);
+
+		while (true)
+		{
+			if (!m_idleConnections.empty())
+			{
+				// Most recently released connection first, so the least used ones can be reaped
+				std::unique_ptr<Database> database = std::move(m_idleConnections.back().database);
+				m_idleConnections.pop_back();
+
+				lock.unlock();
+				const bool healthy = database->isConnectionHealthy(m_poolConfiguration.validateOnCheckout);
+				if (!healthy)
+				{
+					database.reset();
+				}
+				lock.lock();
+
+				if (healthy)
+				{
+					return createLease(std::move(database), requestTime);
+				}
+
+				m_totalConnections--;
+				m_discardedConnections++;
+				continue;
+			}
+
+			if (m_totalConnections < m_poolConfiguration.maxSize)
+			{
+				m_totalConnections++;
+				lock.unlock();
+
+				std::unique_ptr<Database> database;
+				try
+				{
+					database = Connection().openDatabase(m_connectionConfiguration);
+				}
+				catch (...)
+				{
+					lock.lock();
+					m_totalConnections--;
+					m_waitingRequests--;
+					m_connectionAvailable.notify_one();
+					throw;
+				}
+
+				lock.lock();
+				return createLease(std::move(database), requestTime);
+			}
+
+			if (m_connectionAvailable.wait_until(lock, deadline) == std::cv_status::timeout &&
+				m_idleConnections.empty() && m_totalConnections >= m_poolConfiguration.maxSize)
+			{
+				m_waitingRequests--;
+				m_timeouts++;
+				throw CheckoutTimeoutException();
+			}
+		}
+	}
+
+	void ConnectionPool::reapIdleConnections()
+	{
+		std::vector<std::unique_ptr<Database>> expiredConnections;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			expiredConnections = extractExpiredConnections();
+		}
+	}
+
+	ConnectionPool::Statistics ConnectionPool::getStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Statistics statistics;
+		statistics.totalConnections = m_totalConnections;
+		statistics.idleConnections = static_cast<unsigned int>(m_idleConnections.size());
+		statistics.leasedConnections = m_totalConnections - statistics.idleConnections;
+		statistics.waitingRequests = m_waitingRequests;
+		statistics.maxWaitingRequests = m_maxWaitingRequests;
+		statistics.checkouts = m_checkouts;
+		statistics.timeouts = m_timeouts;
+		statistics.discardedConnections = m_discardedConnections;
+		for (std::size_t i = 0; i < LATENCY_BUCKETS_COUNT; i++)
+		{
+			statistics.checkoutLatencyHistogram.push_back({ LATENCY_BUCKETS_UPPER_BOUNDS[i], m_checkoutLatencyCounts[i] });
+		}
+
+		return statistics;
+	}
+
+	ConnectionPool::Lease ConnectionPool::createLease(std::unique_ptr<Database> database, std::chrono::steady_clock::time_point requestTime)
+	{
+		const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - requestTime);
+		const auto bucket = std::ranges::find_if(LATENCY_BUCKETS_UPPER_BOUNDS,
+			[&latency](const std::chrono::microseconds& upperBound)
+			{
+				return latency <= upperBound;
+			});
+
+		m_checkoutLatencyCounts[std::distance(std::begin(LATENCY_BUCKETS_UPPER_BOUNDS), bucket)]++;
+		m_checkouts++;
+		m_waitingRequests--;
+
+		return Lease(*this, std::move(database));
+	}
+
+	void ConnectionPool::release(std::unique_ptr<Database> database)
+	{
+		const bool reusable = database->resetSession();
+		if (!reusable)
+		{
+			database.reset();
+		}
+
+		std::vector<std::unique_ptr<Database>> expiredConnections;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (reusable)
+			{
+				m_idleConnections.push_back({ std::move(database), std::chrono::steady_clock::now() });
+			}
+			else
+			{
+				m_totalConnections--;
+				m_discardedConnections++;
+			}
+
+			expiredConnections = extractExpiredConnections();
+		}
+
+		m_connectionAvailable.notify_one();
+	}
+
+	std::vector<std::unique_ptr<Database>> ConnectionPool::extractExpiredConnections()
+	{
+		// Connections are closed by the caller once the pool lock has been released
+		std::vector<std::unique_ptr<Database>> expiredConnections;
+		const auto expirationTime = std::chrono::steady_clock::now() - m_poolConfiguration.idleTimeout;
+		auto idleIterator = m_idleConnections.begin();
+		while (idleIterator != m_idleConnections.end() && m_totalConnections > m_poolConfiguration.minSize)
+		{
+			if (idleIterator->releaseTime < expirationTime)
+			{
+				expiredConnections.push_back(std::move(idleIterator->database));
+				idleIterator = m_idleConnections.erase(idleIterator);
+				m_totalConnections--;
+			}
+			else
+			{
+				++idleIterator;
+			}
+		}
+
+		return expiredConnections;
+	}
+}
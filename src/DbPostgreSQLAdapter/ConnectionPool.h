@@ -0,0 +1,107 @@
+#pragma once
+
+namespace systelab::db {
+	class IConnectionConfiguration;
+}
+
+namespace systelab::db::postgresql {
+	class Database;
+
+	struct ConnectionPoolConfiguration
+	{
+		unsigned int minSize = 1;
+		unsigned int maxSize = 8;
+		std::chrono::milliseconds checkoutTimeout = std::chrono::seconds(30);
+		std::chrono::milliseconds idleTimeout = std::chrono::minutes(10);
+		bool validateOnCheckout = true;
+	};
+
+	// The pool must outlive every lease it hands out
+	class ConnectionPool
+	{
+	public:
+		class Lease
+		{
+		public:
+			Lease(Lease&&) noexcept;
+			Lease& operator=(Lease&&) noexcept;
+			~Lease();
+
+			Database& get() const;
+			Database& operator*() const;
+			Database* operator->() const;
+
+		private:
+			friend class ConnectionPool;
+			Lease(ConnectionPool& pool, std::unique_ptr<Database> database);
+
+			ConnectionPool* m_pool;
+			std::unique_ptr<Database> m_database;
+
+			void release();
+		};
+
+		struct HistogramBucket
+		{
+			std::chrono::microseconds upperBound;
+			unsigned long long count;
+		};
+
+		struct Statistics
+		{
+			unsigned int totalConnections = 0;
+			unsigned int idleConnections = 0;
+			unsigned int leasedConnections = 0;
+			unsigned int waitingRequests = 0;
+			unsigned int maxWaitingRequests = 0;
+			unsigned long long checkouts = 0;
+			unsigned long long timeouts = 0;
+			unsigned long long discardedConnections = 0;
+			std::vector<HistogramBucket> checkoutLatencyHistogram;
+		};
+
+		ConnectionPool(IConnectionConfiguration& connectionConfiguration, const ConnectionPoolConfiguration& poolConfiguration = {});
+		~ConnectionPool();
+
+		Lease acquire();
+		Lease acquire(std::chrono::milliseconds timeout);
+
+		void reapIdleConnections();
+		Statistics getStatistics() const;
+
+	public:
+		struct CheckoutTimeoutException : public std::runtime_error
+		{
+			CheckoutTimeoutException()
+				: std::runtime_error("Timeout waiting for an available database connection")
+			{}
+		};
+
+	private:
+		struct IdleConnection
+		{
+			std::unique_ptr<Database> database;
+			std::chrono::steady_clock::time_point releaseTime;
+		};
+
+		static constexpr std::size_t LATENCY_BUCKETS_COUNT = 7;
+
+		IConnectionConfiguration& m_connectionConfiguration;
+		const ConnectionPoolConfiguration m_poolConfiguration;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_connectionAvailable;
+		std::vector<IdleConnection> m_idleConnections;
+		unsigned int m_totalConnections = 0;
+		unsigned int m_waitingRequests = 0;
+		unsigned int m_maxWaitingRequests = 0;
+		unsigned long long m_checkouts = 0;
+		unsigned long long m_timeouts = 0;
+		unsigned long long m_discardedConnections = 0;
+		std::array<unsigned long long, LATENCY_BUCKETS_COUNT> m_checkoutLatencyCounts{};
+
+		Lease createLease(std::unique_ptr<Database> database, std::chrono::steady_clock::time_point requestTime);
+		void release(std::unique_ptr<Database> database);
+		std::vector<std::unique_ptr<Database>> extractExpiredConnections();
+	};
+}
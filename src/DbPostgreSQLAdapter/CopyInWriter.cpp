@@ -0,0 +1,251 @@
+#include "stdafx.h"
+#include "CopyInWriter.h"
+
+#include "BinaryValue.h"
+#include "Field.h"
+#include "FieldValue.h"
+#include "PostgresUtils.h"
+#include "TypeRegistry.h"
+
+#include "DbAdapterInterface/IFieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	namespace {
+		const char BINARY_COPY_SIGNATURE[] = { 'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\377', '\r', '\n', '\0' };
+
+		template<typename T>
+		void appendBigEndian(std::string& buffer, T value)
+		{
+			const auto unsignedValue = static_cast<std::make_unsigned_t<T>>(value);
+			for (int shift = static_cast<int>(sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+			{
+				buffer.push_back(static_cast<char>((unsignedValue >> shift) & 0xFF));
+			}
+		}
+
+		template<typename T>
+		void appendNumber(std::string& buffer, T value)
+		{
+			char number[32];
+			const auto [numberEnd, error] = std::to_chars(number, number + sizeof(number), value);
+			buffer.append(number, numberEnd);
+		}
+
+		void appendEscapedText(std::string& buffer, const std::string& value)
+		{
+			for (const char character : value)
+			{
+				switch (character)
+				{
+					case '\\': buffer += "\\\\"; break;
+					case '\n': buffer += "\\n"; break;
+					case '\r': buffer += "\\r"; break;
+					case '\t': buffer += "\\t"; break;
+					default: buffer.push_back(character); break;
+				}
+			}
+		}
+	}
+
+	CopyInWriter::CopyInWriter(PGconn* connection, BusyConnectionLock lock,
+							   const std::string& tableName, const std::vector<const Field*>& columns,
+							   const CopyOptions& options)
+		: m_connection(connection)
+		, m_lock(std::move(lock))
+		, m_columns(columns)
+		, m_format(options.format)
+		, m_bufferSize(std::max<std::size_t>(options.bufferSize, 1))
+		, m_finished(false)
+	{
+		if (m_format == CopyFormat::CSV)
+		{
+			throw std::runtime_error("CSV format not supported by COPY FROM.");
+		}
+
+		std::string columnNames;
+		for (const Field* column : m_columns)
+		{
+			columnNames += (columnNames.empty() ? "" : ",") + column->getName();
+		}
+
+		std::string copyStatement = "COPY " + tableName + " (" + columnNames + ") FROM STDIN";
+		if (m_format == CopyFormat::BINARY)
+		{
+			copyStatement += " (FORMAT binary)";
+		}
+
+		const auto copyResult = utils::createRAIIPGresult(PQexec(m_connection, copyStatement.c_str()));
+		if (PQresultStatus(copyResult.get()) != PGRES_COPY_IN)
+		{
+			utils::throwPostgressException(copyResult.get());
+		}
+
+		m_buffer.reserve(m_bufferSize);
+		if (m_format == CopyFormat::BINARY)
+		{
+			m_buffer.append(BINARY_COPY_SIGNATURE, sizeof(BINARY_COPY_SIGNATURE));
+			appendBigEndian<std::int32_t>(m_buffer, 0);
+			appendBigEndian<std::int32_t>(m_buffer, 0);
+		}
+	}
+
+	CopyInWriter::~CopyInWriter()
+	{
+		if (!m_finished)
+		{
+			abort();
+		}
+	}
+
+	void CopyInWriter::writeRecord(const std::vector<const IFieldValue*>& values)
+	{
+		if (values.size() != m_columns.size())
+		{
+			throw std::runtime_error("Number of values doesn't match the number of copied columns");
+		}
+
+		const std::size_t valuesCount = values.size();
+		if (m_format == CopyFormat::BINARY)
+		{
+			appendBigEndian<std::int16_t>(m_buffer, static_cast<std::int16_t>(valuesCount));
+			for (std::size_t i = 0; i < valuesCount; i++)
+			{
+				writeBinaryValue(*m_columns[i], *values[i]);
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < valuesCount; i++)
+			{
+				if (i > 0)
+				{
+					m_buffer.push_back('\t');
+				}
+				writeTextValue(*values[i]);
+			}
+			m_buffer.push_back('\n');
+		}
+
+		if (m_buffer.size() >= m_bufferSize)
+		{
+			flush();
+		}
+	}
+
+	RowsAffected CopyInWriter::finish()
+	{
+		if (m_format == CopyFormat::BINARY)
+		{
+			appendBigEndian<std::int16_t>(m_buffer, -1);
+		}
+		flush();
+
+		m_finished = true;
+		if (PQputCopyEnd(m_connection, nullptr) != 1)
+		{
+			m_lock.unlock();
+			throw std::runtime_error(std::string("Unable to finish COPY: ") + PQerrorMessage(m_connection));
+		}
+
+		const auto copyResult = utils::createRAIIPGresult(PQgetResult(m_connection));
+		while (PGresult* pendingResult = PQgetResult(m_connection))
+		{
+			PQclear(pendingResult);
+		}
+		m_lock.unlock();
+
+		if (PQresultStatus(copyResult.get()) != PGRES_COMMAND_OK)
+		{
+			utils::throwPostgressException(copyResult.get());
+		}
+
+		return static_cast<RowsAffected>(std::atoi(PQcmdTuples(copyResult.get())));
+	}
+
+	void CopyInWriter::writeTextValue(const IFieldValue& value)
+	{
+		if (value.isNull())
+		{
+			m_buffer += "\\N";
+			return;
+		}
+
+		switch (value.getField().getType())
+		{
+			case BOOLEAN:
+				m_buffer.push_back(value.getBooleanValue() ? 't' : 'f');
+				break;
+			case INT:
+				appendNumber(m_buffer, utils::getBigIntValue(value));
+				break;
+			case DOUBLE:
+				appendNumber(m_buffer, value.getDoubleValue());
+				break;
+			case STRING:
+				appendEscapedText(m_buffer, value.getStringValue());
+				break;
+			case DATETIME:
+				m_buffer += utils::dateTimeToISOString(value.getDateTimeValue());
+				break;
+			case BINARY:
+			{
+				std::string streamedData;
+				std::string byteaText;
+				utils::appendByteaText(utils::getBinaryData(value.getBinaryValue(), streamedData), byteaText);
+				appendEscapedText(m_buffer, byteaText);
+			}
+			break;
+			default:
+				throw std::runtime_error("Field type not supported by COPY.");
+		}
+	}
+
+	void CopyInWriter::writeBinaryValue(const Field& column, const IFieldValue& value)
+	{
+		if (value.isNull())
+		{
+			appendBigEndian<std::int32_t>(m_buffer, -1);
+			return;
+		}
+
+		const TypeHandler* handler = TypeRegistry::getInstance().findHandler(column.getTypeOID());
+		if (handler == nullptr || handler->binaryEncoder == nullptr)
+		{
+			throw std::runtime_error("Binary COPY not supported for type OID " + std::to_string(static_cast<int>(column.getTypeOID())));
+		}
+
+		// The length goes before the value, so it is filled in once the value is encoded
+		const std::size_t lengthPosition = m_buffer.size();
+		appendBigEndian<std::int32_t>(m_buffer, 0);
+		handler->binaryEncoder(value, m_buffer);
+
+		std::string encodedLength;
+		appendBigEndian(encodedLength, static_cast<std::int32_t>(m_buffer.size() - lengthPosition - sizeof(std::int32_t)));
+		m_buffer.replace(lengthPosition, encodedLength.size(), encodedLength);
+	}
+
+	void CopyInWriter::flush()
+	{
+		if (m_buffer.empty())
+		{
+			return;
+		}
+
+		if (PQputCopyData(m_connection, m_buffer.data(), static_cast<int>(m_buffer.size())) != 1)
+		{
+			throw std::runtime_error(std::string("Unable to send COPY data: ") + PQerrorMessage(m_connection));
+		}
+
+		m_buffer.clear();
+	}
+
+	void CopyInWriter::abort()
+	{
+		PQputCopyEnd(m_connection, "COPY aborted by client");
+		while (PGresult* pendingResult = PQgetResult(m_connection))
+		{
+			PQclear(pendingResult);
+		}
+	}
+}
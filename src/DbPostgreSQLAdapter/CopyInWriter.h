@@ -0,0 +1,46 @@
+#pragma once
+
+#include "DbAdapterInterface/Types.h"
+
+#include "BusyConnectionLock.h"
+#include "CopyOptions.h"
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db {
+	class IFieldValue;
+}
+
+namespace systelab::db::postgresql {
+	class Field;
+
+	// Streams rows into a table through COPY ... FROM STDIN. Rows are buffered and sent to the server
+	// each time the buffer is full; on a blocking connection sending waits until the server catches up.
+	// The connection is kept locked and busy until the copy is finished or the writer is destroyed, so the
+	// writer must be used and destroyed on the thread that created it.
+	class CopyInWriter
+	{
+	public:
+		CopyInWriter(PGconn* connection, BusyConnectionLock lock,
+					 const std::string& tableName, const std::vector<const Field*>& columns,
+					 const CopyOptions& options);
+		~CopyInWriter();
+
+		void writeRecord(const std::vector<const IFieldValue*>& values);
+		RowsAffected finish();
+
+	private:
+		PGconn* m_connection;
+		BusyConnectionLock m_lock;
+		std::vector<const Field*> m_columns;
+		CopyFormat m_format;
+		std::size_t m_bufferSize;
+		std::string m_buffer;
+		bool m_finished;
+
+		void writeTextValue(const IFieldValue& value);
+		void writeBinaryValue(const Field& column, const IFieldValue& value);
+		void flush();
+		void abort();
+	};
+}
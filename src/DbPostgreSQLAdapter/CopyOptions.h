@@ -0,0 +1,17 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+	enum class CopyFormat {
+		TEXT = 0,
+		BINARY = 1,
+		// Only supported when copying out of the database
+		CSV = 2
+	};
+
+	struct CopyOptions
+	{
+		CopyFormat format = CopyFormat::TEXT;
+		std::size_t bufferSize = 1024 * 1024;
+		bool returnPrimaryKeys = false;
+	};
+}
@@ -1,17 +1,104 @@
 #include "stdafx.h"
 
 #include "Database.h"
+#include "AsyncOperation.h"
+#include "AsyncReactor.h"
+#include "ColumnarRecordSet.h"
+#include "CopyInWriter.h"
 #include "DbAdapterInterface/ITable.h"
+#include "LargeObject.h"
+#include "Pipeline.h"
 #include "PostgresUtils.h"
 #include "RecordSet.h"
+#include "ResultStream.h"
+#include "SchemaCache.h"
+#include "SchemaLoader.h"
+#include "StatementParameters.h"
+#include "StreamingRecordSet.h"
+#include "StreamingTableRecordSet.h"
 #include "Table.h"
 #include "TableRecordSet.h"
 #include "Transaction.h"
+#include "TypeRegistry.h"
 
 namespace systelab::db::postgresql {
 
+	namespace {
+		const unsigned int DEFAULT_PREPARED_STATEMENT_CACHE_CAPACITY = 256;
+		const unsigned int DEFAULT_PIPELINE_MAX_PENDING_STATEMENTS = 256;
+		const std::string SCHEMA_CHANGES_CHANNEL = "systelab_schema_changed";
+
+		std::string getCopyFormatOption(CopyFormat format)
+		{
+			switch (format)
+			{
+				case CopyFormat::TEXT:
+					return "";
+				case CopyFormat::BINARY:
+					return " (FORMAT binary)";
+				case CopyFormat::CSV:
+					return " (FORMAT csv)";
+				default:
+					throw std::runtime_error("Unknown COPY format.");
+			}
+		}
+
+		void writeToFileDescriptor(int fileDescriptor, std::string_view data)
+		{
+			while (!data.empty())
+			{
+#ifdef _WIN32
+				const int writtenSize = _write(fileDescriptor, data.data(), static_cast<unsigned int>(data.size()));
+#else
+				const ssize_t writtenSize = ::write(fileDescriptor, data.data(), data.size());
+#endif
+				if (writtenSize < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+
+					throw std::runtime_error("Unable to write COPY data: " + std::string(std::strerror(errno)));
+				}
+
+				data.remove_prefix(static_cast<std::size_t>(writtenSize));
+			}
+		}
+
+		bool isSchemaChangeCommand(std::string_view command)
+		{
+			return command.starts_with("CREATE") || command.starts_with("ALTER") || command.starts_with("DROP");
+		}
+
+		// SQLSTATE 0A000 is also reported when a cached plan no longer matches the result type of its statement
+		bool isFeatureNotSupportedError(const PGresult* statementResult)
+		{
+			const char* sqlState = PQresultErrorField(statementResult, PG_DIAG_SQLSTATE);
+			return sqlState != nullptr && std::string_view(sqlState) == "0A000";
+		}
+
+		bool hasIntegerFirstColumn(const PGresult* statementResult)
+		{
+			if (PQnfields(statementResult) == 0 || PQfformat(statementResult, 0) != 0)
+			{
+				return false;
+			}
+
+			const TypeHandler* handler = TypeRegistry::getInstance().findHandler(static_cast<PostgresqlOID>(PQftype(statementResult, 0)));
+			return handler != nullptr && handler->fieldType == INT;
+		}
+
+		std::string getConnectionValue(const char* value)
+		{
+			return (value != nullptr) ? std::string(value) : std::string();
+		}
+	}
+
 	Database::Database(PGconn* database)
 		: m_database(database)
+		, m_preparedStatements(database, DEFAULT_PREPARED_STATEMENT_CACHE_CAPACITY)
+		, m_lifetimeToken(std::make_shared<bool>(true))
 	{
 	}
 
@@ -22,19 +109,73 @@ namespace systelab::db::postgresql {
 
 	ITable& Database::getTable(const std::string& tableName)
 	{
-		auto tableIterator = m_tables.find(tableName);
-		if (tableIterator == m_tables.cend())
+		if (ITable* table = findTable(tableName))
+		{
+			return *table;
+		}
+
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		processSchemaChangeNotifications();
+
+		// Another thread may have loaded it while this one waited for the connection
+		if (ITable* table = findTable(tableName))
+		{
+			return *table;
+		}
+
+		// Every spelling of a relation shares its table. Tables are only added with the connection locked
+		const unsigned int relationOID = utils::resolveRelationOID(*this, tableName);
+		ITable* table = findTable(relationOID);
+		if (table == nullptr)
+		{
+			table = &addTable(relationOID, std::make_unique<Table>(*this, tableName, relationOID));
+		}
+
+		addTableName(tableName, *table);
+		return *table;
+	}
+
+	unsigned int Database::preloadSchema(const std::string& schemaName)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		processSchemaChangeNotifications();
+
+		SchemaCache& schemaCache = SchemaCache::getInstance();
+		const std::string schemaCacheKey = getSchemaCacheKey();
+		const auto loadVersion = schemaCache.getVersion(schemaCacheKey);
+
+		unsigned int loadedTablesCount = 0;
+		auto schemaTables = utils::loadSchemaTables(*this, schemaName);
+		for (auto& [relationOID, schemaTable] : schemaTables)
 		{
-			tableIterator = m_tables.emplace(tableName, std::make_unique<Table>(*this, tableName)).first;
+			schemaCache.addTableSchema(schemaCacheKey, std::move(schemaTable.schema), loadVersion);
+			ITable* table = findTable(relationOID);
+			if (table == nullptr)
+			{
+				table = &addTable(relationOID, std::make_unique<Table>(*this, schemaTable.names.front(), relationOID));
+				loadedTablesCount++;
+			}
+
+			for (const auto& tableName : schemaTable.names)
+			{
+				addTableName(tableName, *table);
+			}
 		}
 
-		return *(*tableIterator).second;
+		return loadedTablesCount;
 	}
 
 	std::unique_ptr<IRecordSet> Database::executeQuery(const std::string& query)
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
-		const auto statementResult = utils::createRAIIPGresult(PQexec(m_database, query.c_str()));
+		return executeQuery(query, m_resultFormat);
+	}
+
+	std::unique_ptr<IRecordSet> Database::executeQuery(const std::string& query, ResultFormat resultFormat)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		const auto statementResult = utils::createRAIIPGresult(execute(query, resultFormat));
 		if (PQresultStatus(statementResult.get()) == PGRES_TUPLES_OK)
 		{
 			return std::make_unique<RecordSet>(statementResult.get());
@@ -43,10 +184,52 @@ namespace systelab::db::postgresql {
 		utils::throwPostgressException(statementResult.get());
 	}
 
+	std::unique_ptr<IRecordSet> Database::executeQuery(const std::string& query, RecordSetMode recordSetMode)
+	{
+		if (recordSetMode == RecordSetMode::STREAMING)
+		{
+			return std::make_unique<StreamingRecordSet>(executeStreaming(query));
+		}
+		else if (recordSetMode == RecordSetMode::LAZY)
+		{
+			std::lock_guard<ConnectionMutex> lock(m_mutex);
+			return std::make_unique<RecordSet>(executeRetained(query));
+		}
+
+		return executeQuery(query, m_resultFormat);
+	}
+
+	std::unique_ptr<ColumnarRecordSet> Database::executeColumnarQuery(const std::string& query)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		const auto statementResult = utils::createRAIIPGresult(execute(query, m_resultFormat));
+		if (PQresultStatus(statementResult.get()) == PGRES_TUPLES_OK)
+		{
+			return std::make_unique<ColumnarRecordSet>(statementResult.get());
+		}
+
+		utils::throwPostgressException(statementResult.get());
+	}
+
+	std::unique_ptr<ITableRecordSet> Database::executeTableQuery(const std::string& query, ITable& table, RecordSetMode recordSetMode)
+	{
+		if (recordSetMode == RecordSetMode::STREAMING)
+		{
+			return std::make_unique<StreamingTableRecordSet>(table, executeStreaming(query));
+		}
+		else if (recordSetMode == RecordSetMode::LAZY)
+		{
+			std::lock_guard<ConnectionMutex> lock(m_mutex);
+			return std::make_unique<TableRecordSet>(table, executeRetained(query));
+		}
+
+		return executeTableQuery(query, table);
+	}
+
 	std::unique_ptr<ITableRecordSet> Database::executeTableQuery(const std::string& query, ITable& table)
 	{	
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
-		const auto statementResult = utils::createRAIIPGresult(PQexec(m_database, query.c_str()));
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		const auto statementResult = utils::createRAIIPGresult(execute(query, m_resultFormat));
 		if (PQresultStatus(statementResult.get()) == PGRES_TUPLES_OK)
 		{
 			return std::make_unique<TableRecordSet>(table, statementResult.get());
@@ -57,22 +240,23 @@ namespace systelab::db::postgresql {
 
 	void Database::executeOperation(const std::string& operation)
 	{
-		std::lock_guard<std::recursive_mutex> lock(m_mutex);
+		executeOperationWithResult(operation);
+	}
+
+	OperationResult Database::executeOperationWithResult(const std::string& operation)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		const auto startTime = std::chrono::steady_clock::now();
 		const auto statementResult = utils::createRAIIPGresult(PQexec(m_database, operation.c_str()));
-		const auto result = PQresultStatus(statementResult.get());
-		if (result == PGRES_TUPLES_OK)
+		OperationResult operationResult = processOperationResult(statementResult.get(), startTime);
+		if (isSchemaChangeCommand(operationResult.commandTag))
 		{
-			// Retrieve last inserted id. Requires that the query returns the id
-			const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult.get()));
-			const std::string rowId = PQgetvalue(statementResult.get(), 0, rowsCount-1);
-			m_lastInsertedRowId = std::stoi(rowId);
-		}
-		else if (result != PGRES_COMMAND_OK)
-		{
-			utils::throwPostgressException(statementResult.get());
+			invalidateSchema(getSchemaCacheKey());
 		}
 
-		m_lastOperationRowsAffected = std::atoi(PQcmdTuples(statementResult.get()));
+		setLastOperation(operationResult);
+		return operationResult;
 	}
 
 	void Database::executeMultipleStatements(const std::string& statements)
@@ -82,16 +266,544 @@ namespace systelab::db::postgresql {
 
 	RowsAffected Database::getRowsAffectedByLastChangeOperation() const
 	{
-		return m_lastOperationRowsAffected;
+		return getLastOperation().rowsAffected;
 	}
 
 	RowId Database::getLastInsertedRowId() const
 	{
-		return m_lastInsertedRowId;
+		return utils::toIntValue(getLastOperation().insertedRowId);
+	}
+
+	std::vector<RowId> Database::getLastInsertedRowIds() const
+	{
+		const std::vector<std::int64_t> insertedRowIds = getLastOperation().insertedRowIds;
+		std::vector<RowId> rowIds;
+		rowIds.reserve(insertedRowIds.size());
+		std::transform(insertedRowIds.cbegin(), insertedRowIds.cend(), std::back_inserter(rowIds), utils::toIntValue);
+		return rowIds;
 	}
 
 	std::unique_ptr<ITransaction> Database::startTransaction()
 	{
 		return std::make_unique<Transaction>(*this);
 	}
+
+	std::unique_ptr<ITableRecordSet> Database::executePreparedTableQuery(const std::string& statementKey,
+																		 const std::function<std::string()>& queryBuilder,
+																		 const StatementParameters& parameters,
+																		 ITable& table)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		const auto statementResult = utils::createRAIIPGresult(executePrepared(statementKey, queryBuilder, parameters, m_resultFormat));
+		if (PQresultStatus(statementResult.get()) == PGRES_TUPLES_OK)
+		{
+			return std::make_unique<TableRecordSet>(table, statementResult.get());
+		}
+
+		utils::throwPostgressException(statementResult.get());
+	}
+
+	OperationResult Database::executePreparedOperation(const std::string& statementKey,
+													   const std::function<std::string()>& operationBuilder,
+													   const StatementParameters& parameters)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		const auto startTime = std::chrono::steady_clock::now();
+		const auto statementResult = utils::createRAIIPGresult(executePrepared(statementKey, operationBuilder, parameters, ResultFormat::TEXT));
+		OperationResult operationResult = processOperationResult(statementResult.get(), startTime);
+		if (isSchemaChangeCommand(operationResult.commandTag))
+		{
+			invalidateSchema(getSchemaCacheKey());
+		}
+
+		setLastOperation(operationResult);
+		return operationResult;
+	}
+
+	std::unique_ptr<CopyInWriter> Database::startCopyIn(const std::string& tableName,
+														const std::vector<const Field*>& columns,
+														const CopyOptions& options)
+	{
+		return std::make_unique<CopyInWriter>(m_database, lockBusyConnection(), tableName, columns, options);
+	}
+
+	RowsAffected Database::copyOut(const std::string& query, const std::function<void(std::string_view)>& sink, CopyFormat format)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		const std::string copyStatement = "COPY (" + query + ") TO STDOUT" + getCopyFormatOption(format);
+		auto copyResult = utils::createRAIIPGresult(PQexec(m_database, copyStatement.c_str()));
+		if (PQresultStatus(copyResult.get()) != PGRES_COPY_OUT)
+		{
+			utils::throwPostgressException(copyResult.get());
+		}
+
+		std::exception_ptr sinkError;
+		char* data = nullptr;
+		int dataSize = 0;
+		while ((dataSize = PQgetCopyData(m_database, &data, 0)) > 0)
+		{
+			// The rest of the data is drained after a failure, so the connection can be used again
+			std::unique_ptr<char, void(*)(void*)> chunk(data, PQfreemem);
+			if (!sinkError)
+			{
+				try
+				{
+					sink(std::string_view(chunk.get(), static_cast<std::size_t>(dataSize)));
+				}
+				catch (...)
+				{
+					sinkError = std::current_exception();
+					PGcancel* cancelRequest = PQgetCancel(m_database);
+					if (cancelRequest)
+					{
+						char errorBuffer[256];
+						PQcancel(cancelRequest, errorBuffer, sizeof(errorBuffer));
+						PQfreeCancel(cancelRequest);
+					}
+				}
+			}
+		}
+
+		copyResult = utils::createRAIIPGresult(PQgetResult(m_database));
+		while (PGresult* pendingResult = PQgetResult(m_database))
+		{
+			PQclear(pendingResult);
+		}
+
+		if (sinkError)
+		{
+			std::rethrow_exception(sinkError);
+		}
+
+		if (dataSize == -2)
+		{
+			throw std::runtime_error(std::string("Unable to receive COPY data: ") + PQerrorMessage(m_database));
+		}
+
+		if (PQresultStatus(copyResult.get()) != PGRES_COMMAND_OK)
+		{
+			utils::throwPostgressException(copyResult.get());
+		}
+
+		return static_cast<RowsAffected>(std::atoi(PQcmdTuples(copyResult.get())));
+	}
+
+	RowsAffected Database::copyOut(const std::string& query, std::ostream& outputStream, CopyFormat format)
+	{
+		return copyOut(query,
+			[&outputStream](std::string_view data)
+			{
+				if (!outputStream.write(data.data(), static_cast<std::streamsize>(data.size())))
+				{
+					throw std::runtime_error("Unable to write COPY data to the output stream");
+				}
+			}, format);
+	}
+
+	RowsAffected Database::copyOut(const std::string& query, int fileDescriptor, CopyFormat format)
+	{
+		return copyOut(query,
+			[fileDescriptor](std::string_view data)
+			{
+				writeToFileDescriptor(fileDescriptor, data);
+			}, format);
+	}
+
+	std::future<std::unique_ptr<IRecordSet>> Database::executeQueryAsync(AsyncReactor& reactor, const std::string& query)
+	{
+		auto promise = std::make_shared<std::promise<std::unique_ptr<IRecordSet>>>();
+		auto future = promise->get_future();
+		reactor.submit(std::make_unique<AsyncOperation>(m_database, m_mutex, query, m_resultFormat,
+			[promise](const PGresult* statementResult)
+			{
+				if (PQresultStatus(statementResult) != PGRES_TUPLES_OK)
+				{
+					utils::throwPostgressException(statementResult);
+				}
+
+				promise->set_value(std::make_unique<RecordSet>(statementResult));
+			},
+			[promise](std::exception_ptr error)
+			{
+				promise->set_exception(error);
+			}));
+
+		return future;
+	}
+
+	std::future<RowsAffected> Database::executeOperationAsync(AsyncReactor& reactor, const std::string& operation)
+	{
+		// Resolved beforehand, as the completion runs on the reactor thread where no blocking statement can be issued
+		const std::string schemaCacheKey = getSchemaCacheKey();
+
+		auto promise = std::make_shared<std::promise<RowsAffected>>();
+		auto future = promise->get_future();
+		const auto startTime = std::chrono::steady_clock::now();
+		reactor.submit(std::make_unique<AsyncOperation>(m_database, m_mutex, operation, ResultFormat::TEXT,
+			[this, promise, startTime, schemaCacheKey](const PGresult* statementResult)
+			{
+				const OperationResult operationResult = processOperationResult(statementResult, startTime);
+				if (isSchemaChangeCommand(operationResult.commandTag))
+				{
+					invalidateSchema(schemaCacheKey);
+				}
+
+				promise->set_value(operationResult.rowsAffected);
+			},
+			[promise](std::exception_ptr error)
+			{
+				promise->set_exception(error);
+			}));
+
+		return future;
+	}
+
+	std::unique_ptr<Pipeline> Database::startPipeline()
+	{
+		return startPipeline(DEFAULT_PIPELINE_MAX_PENDING_STATEMENTS);
+	}
+
+	std::unique_ptr<Pipeline> Database::startPipeline(unsigned int maxPendingStatements)
+	{
+		// Resolved beforehand, as no other statement can be issued while the pipeline holds the connection
+		const std::string schemaCacheKey = getSchemaCacheKey();
+		return std::make_unique<Pipeline>(m_database, lockBusyConnection(), maxPendingStatements,
+			[this, schemaCacheKey](std::string_view commandTag)
+			{
+				if (isSchemaChangeCommand(commandTag))
+				{
+					invalidateSchema(schemaCacheKey);
+				}
+			});
+	}
+
+	std::unique_ptr<LargeObject> Database::createLargeObject()
+	{
+		return createLargeObject(LargeObject::DEFAULT_CHUNK_SIZE);
+	}
+
+	std::unique_ptr<LargeObject> Database::createLargeObject(std::size_t chunkSize)
+	{
+		return openLargeObject(LargeObject::NEW_OBJECT, LargeObjectMode::READ_WRITE, chunkSize);
+	}
+
+	std::unique_ptr<LargeObject> Database::openLargeObject(unsigned int oid, LargeObjectMode mode)
+	{
+		return openLargeObject(oid, mode, LargeObject::DEFAULT_CHUNK_SIZE);
+	}
+
+	std::unique_ptr<LargeObject> Database::openLargeObject(unsigned int oid, LargeObjectMode mode, std::size_t chunkSize)
+	{
+		return std::make_unique<LargeObject>(m_database, lockBusyConnection(), oid, mode, chunkSize);
+	}
+
+	void Database::unlinkLargeObject(unsigned int oid)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		if (lo_unlink(m_database, oid) != 1)
+		{
+			throw std::runtime_error(std::string("Unable to unlink large object: ") + PQerrorMessage(m_database));
+		}
+	}
+
+	PreparedStatementCache::Statistics Database::getPreparedStatementCacheStatistics() const
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		return m_preparedStatements.getStatistics();
+	}
+
+	void Database::setPreparedStatementCacheCapacity(unsigned int capacity)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		m_connectionState.checkAvailable();
+		m_preparedStatements.setCapacity(capacity);
+	}
+
+	std::string Database::getSchemaCacheKey()
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		if (m_schemaCacheKey.empty())
+		{
+			m_connectionState.checkAvailable();
+			// Database OID is part of the key so a dropped and recreated database does not reuse stale entries
+			const auto oidResult = utils::createRAIIPGresult(PQexec(m_database, "SELECT oid FROM pg_database WHERE datname = current_database()"));
+			if (PQresultStatus(oidResult.get()) != PGRES_TUPLES_OK || PQntuples(oidResult.get()) != 1)
+			{
+				utils::throwPostgressException(oidResult.get());
+			}
+
+			m_schemaCacheKey = getConnectionValue(PQhost(m_database)) + ":" + getConnectionValue(PQport(m_database)) + "/" +
+							   getConnectionValue(PQdb(m_database)) + "/" + PQgetvalue(oidResult.get(), 0, 0);
+		}
+
+		return m_schemaCacheKey;
+	}
+
+	void Database::listenForSchemaChanges()
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		executeOperation("LISTEN " + SCHEMA_CHANGES_CHANNEL);
+		m_listeningForSchemaChanges = true;
+	}
+
+	void Database::installSchemaChangeTrigger()
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		executeOperation("CREATE OR REPLACE FUNCTION " + SCHEMA_CHANGES_CHANNEL + "_notify() RETURNS event_trigger "
+						 "LANGUAGE plpgsql AS $$ BEGIN PERFORM pg_notify('" + SCHEMA_CHANGES_CHANNEL + "', current_database()); END; $$");
+		executeOperation("DROP EVENT TRIGGER IF EXISTS " + SCHEMA_CHANGES_CHANNEL);
+		executeOperation("CREATE EVENT TRIGGER " + SCHEMA_CHANGES_CHANNEL + " ON ddl_command_end "
+						 "EXECUTE FUNCTION " + SCHEMA_CHANGES_CHANNEL + "_notify()");
+	}
+
+	bool Database::isConnectionHealthy(bool ping)
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		if (m_connectionState.busy || m_connectionState.broken || PQstatus(m_database) != CONNECTION_OK)
+		{
+			return false;
+		}
+
+		if (ping)
+		{
+			const auto pingResult = utils::createRAIIPGresult(PQexec(m_database, "SELECT 1"));
+			return PQresultStatus(pingResult.get()) == PGRES_TUPLES_OK;
+		}
+
+		return true;
+	}
+
+	bool Database::resetSession()
+	{
+		std::lock_guard<ConnectionMutex> lock(m_mutex);
+		if (m_connectionState.busy || m_connectionState.broken)
+		{
+			return false;
+		}
+
+		// The result format is chosen per lease, so the next one starts from the default again
+		m_resultFormat = ResultFormat::TEXT;
+
+		const auto transactionStatus = PQtransactionStatus(m_database);
+		if (transactionStatus == PQTRANS_INTRANS || transactionStatus == PQTRANS_INERROR)
+		{
+			const auto rollbackResult = utils::createRAIIPGresult(PQexec(m_database, "ROLLBACK"));
+			return PQresultStatus(rollbackResult.get()) == PGRES_COMMAND_OK;
+		}
+
+		return transactionStatus == PQTRANS_IDLE;
+	}
+
+	ResultFormat Database::getResultFormat() const
+	{
+		return m_resultFormat;
+	}
+
+	void Database::setResultFormat(ResultFormat resultFormat)
+	{
+		m_resultFormat = resultFormat;
+	}
+
+	BusyConnectionLock Database::lockBusyConnection()
+	{
+		return BusyConnectionLock(m_mutex, m_connectionState);
+	}
+
+	PGresult* Database::execute(const std::string& statement, ResultFormat resultFormat)
+	{
+		m_connectionState.checkAvailable();
+		if (resultFormat == ResultFormat::TEXT)
+		{
+			return PQexec(m_database, statement.c_str());
+		}
+
+		// Binary results can only be requested through the extended query protocol (single statement)
+		return PQexecParams(m_database, statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, static_cast<int>(resultFormat));
+	}
+
+	std::unique_ptr<ResultStream> Database::executeStreaming(const std::string& query)
+	{
+		return std::make_unique<ResultStream>(m_database, lockBusyConnection(), query, m_resultFormat);
+	}
+
+	std::shared_ptr<const PGresult> Database::executeRetained(const std::string& query)
+	{
+		auto statementResult = utils::createRAIIPGresult(execute(query, m_resultFormat));
+		if (PQresultStatus(statementResult.get()) != PGRES_TUPLES_OK)
+		{
+			utils::throwPostgressException(statementResult.get());
+		}
+
+		return statementResult;
+	}
+
+	PGresult* Database::executePrepared(const std::string& statementKey,
+										const std::function<std::string()>& statementBuilder,
+										const StatementParameters& parameters,
+										ResultFormat resultFormat)
+	{
+		m_connectionState.checkAvailable();
+
+		// Cached plans are dropped after DDL, which may be detected on the reactor thread or notified by other connections
+		processSchemaChangeNotifications();
+		if (m_preparedStatementsStale.exchange(false))
+		{
+			m_preparedStatements.clear();
+		}
+
+		PGresult* statementResult = executeCachedStatement(statementKey, statementBuilder, parameters, resultFormat);
+
+		// A table altered by another session without notifying it invalidates the plan ("cached plan must not change
+		// result type"). The statement is prepared again and retried once, unless the failure aborted a transaction
+		if (isFeatureNotSupportedError(statementResult))
+		{
+			m_preparedStatements.remove(statementKey);
+			if (PQtransactionStatus(m_database) != PQTRANS_INERROR)
+			{
+				PQclear(statementResult);
+				statementResult = executeCachedStatement(statementKey, statementBuilder, parameters, resultFormat);
+			}
+		}
+
+		return statementResult;
+	}
+
+	PGresult* Database::executeCachedStatement(const std::string& statementKey,
+											   const std::function<std::string()>& statementBuilder,
+											   const StatementParameters& parameters,
+											   ResultFormat resultFormat)
+	{
+		const std::string& statementName = m_preparedStatements.getStatementName(statementKey, statementBuilder, parameters.getCount());
+		return PQexecPrepared(m_database, statementName.c_str(), static_cast<int>(parameters.getCount()),
+							  parameters.getValues(), parameters.getLengths(), parameters.getFormats(), static_cast<int>(resultFormat));
+	}
+
+	ITable* Database::findTable(const std::string& tableName) const
+	{
+		std::shared_lock<std::shared_mutex> tablesLock(m_tablesMutex);
+		const auto tableIterator = m_tableNames.find(tableName);
+		return (tableIterator != m_tableNames.cend()) ? tableIterator->second : nullptr;
+	}
+
+	ITable* Database::findTable(unsigned int relationOID) const
+	{
+		std::shared_lock<std::shared_mutex> tablesLock(m_tablesMutex);
+		const auto tableIterator = m_tables.find(relationOID);
+		return (tableIterator != m_tables.cend()) ? tableIterator->second.get() : nullptr;
+	}
+
+	ITable& Database::addTable(unsigned int relationOID, std::unique_ptr<ITable> table)
+	{
+		std::unique_lock<std::shared_mutex> tablesLock(m_tablesMutex);
+		return *m_tables.emplace(relationOID, std::move(table)).first->second;
+	}
+
+	void Database::addTableName(const std::string& tableName, ITable& table)
+	{
+		std::unique_lock<std::shared_mutex> tablesLock(m_tablesMutex);
+		m_tableNames.try_emplace(tableName, &table);
+	}
+
+	Database::LastOperation Database::getLastOperation() const
+	{
+		const auto& lastOperations = getThreadLastOperations();
+		const auto lastOperationIterator = lastOperations.find(this);
+		if (lastOperationIterator == lastOperations.cend() || lastOperationIterator->second.database.lock() != m_lifetimeToken)
+		{
+			return LastOperation();
+		}
+
+		return lastOperationIterator->second;
+	}
+
+	void Database::setLastOperation(const OperationResult& operationResult)
+	{
+		auto& lastOperations = getThreadLastOperations();
+		std::erase_if(lastOperations,
+			[](const auto& lastOperationEntry)
+			{
+				return lastOperationEntry.second.database.expired();
+			});
+
+		LastOperation& lastOperation = lastOperations[this];
+		if (lastOperation.database.lock() != m_lifetimeToken)
+		{
+			lastOperation = LastOperation();
+			lastOperation.database = m_lifetimeToken;
+		}
+
+		lastOperation.rowsAffected = operationResult.rowsAffected;
+		if (!operationResult.returnedKeys.empty())
+		{
+			lastOperation.insertedRowId = operationResult.returnedKeys.back();
+		}
+		lastOperation.insertedRowIds = operationResult.returnedKeys;
+	}
+
+	std::unordered_map<const Database*, Database::LastOperation>& Database::getThreadLastOperations()
+	{
+		thread_local std::unordered_map<const Database*, LastOperation> lastOperations;
+		return lastOperations;
+	}
+
+	OperationResult Database::processOperationResult(const PGresult* statementResult, std::chrono::steady_clock::time_point startTime)
+	{
+		OperationResult operationResult;
+		const auto result = PQresultStatus(statementResult);
+		if (result == PGRES_TUPLES_OK && hasIntegerFirstColumn(statementResult))
+		{
+			// Retrieve inserted ids from the first returned column. Other RETURNING lists leave the keys empty,
+			// as does a null key, so the keys always match the returned rows
+			const int rowsCount = PQntuples(statementResult);
+			operationResult.returnedKeys.reserve(rowsCount);
+			for (int i = 0; i < rowsCount; i++)
+			{
+				if (PQgetisnull(statementResult, i, 0))
+				{
+					operationResult.returnedKeys.clear();
+					break;
+				}
+
+				const std::string_view returnedKey(PQgetvalue(statementResult, i, 0), static_cast<std::size_t>(PQgetlength(statementResult, i, 0)));
+				operationResult.returnedKeys.push_back(utils::parseBigIntValue(returnedKey));
+			}
+		}
+		else if (result != PGRES_COMMAND_OK)
+		{
+			utils::throwPostgressException(statementResult);
+		}
+
+		operationResult.rowsAffected = std::atoi(PQcmdTuples(const_cast<PGresult*>(statementResult)));
+		operationResult.commandTag = PQcmdStatus(const_cast<PGresult*>(statementResult));
+		operationResult.duration = std::chrono::steady_clock::now() - startTime;
+		return operationResult;
+	}
+
+	void Database::processSchemaChangeNotifications()
+	{
+		if (!m_listeningForSchemaChanges || !PQconsumeInput(m_database))
+		{
+			return;
+		}
+
+		bool schemaChanged = false;
+		while (PGnotify* notification = PQnotifies(m_database))
+		{
+			schemaChanged = schemaChanged || (SCHEMA_CHANGES_CHANNEL == notification->relname);
+			PQfreemem(notification);
+		}
+
+		if (schemaChanged)
+		{
+			invalidateSchema(getSchemaCacheKey());
+		}
+	}
+
+	void Database::invalidateSchema(const std::string& schemaCacheKey)
+	{
+		SchemaCache::getInstance().invalidate(schemaCacheKey);
+		m_preparedStatementsStale = true;
+	}
 }
\ No newline at end of file
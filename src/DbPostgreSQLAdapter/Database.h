@@ -3,6 +3,15 @@
 #include "DbAdapterInterface/IDatabase.h"
 #include "DbAdapterInterface/ITable.h"
 
+#include "BusyConnectionLock.h"
+#include "ConnectionMutex.h"
+#include "CopyOptions.h"
+#include "LargeObjectMode.h"
+#include "OperationResult.h"
+#include "PreparedStatementCache.h"
+#include "RecordSetMode.h"
+#include "ResultFormat.h"
+
 namespace systelab::db {
 	class IRecordSet;
 	class ITable;
@@ -11,8 +20,17 @@ namespace systelab::db {
 }
 
 typedef struct pg_conn PGconn;
+typedef struct pg_result PGresult;
 
 namespace systelab::db::postgresql {
+	class AsyncReactor;
+	class ColumnarRecordSet;
+	class CopyInWriter;
+	class Field;
+	class LargeObject;
+	class Pipeline;
+	class ResultStream;
+	class StatementParameters;
 
 	class Database : public IDatabase
 	{
@@ -21,19 +39,122 @@ namespace systelab::db::postgresql {
 		~Database() override;
 
 		ITable& getTable(const std::string& tableName) override;
+		// Loads every table of the schema with one catalog query. They can then be requested by their schema
+		// qualified name, or unqualified when visible through the search_path, without querying the server
+		unsigned int preloadSchema(const std::string& schemaName);
 		std::unique_ptr<IRecordSet> executeQuery(const std::string& query) override;
+		std::unique_ptr<IRecordSet> executeQuery(const std::string& query, ResultFormat resultFormat);
+		std::unique_ptr<IRecordSet> executeQuery(const std::string& query, RecordSetMode recordSetMode);
+		std::unique_ptr<ColumnarRecordSet> executeColumnarQuery(const std::string& query);
 		std::unique_ptr<ITableRecordSet> executeTableQuery(const std::string& query, ITable& table);
+		std::unique_ptr<ITableRecordSet> executeTableQuery(const std::string& query, ITable& table, RecordSetMode recordSetMode);
 		void executeOperation(const std::string& operation) override;
+		OperationResult executeOperationWithResult(const std::string& operation);
 		void executeMultipleStatements(const std::string& statements) override;
 		RowsAffected getRowsAffectedByLastChangeOperation() const override;
 		RowId getLastInsertedRowId() const override;
+		std::vector<RowId> getLastInsertedRowIds() const;
 		std::unique_ptr<ITransaction> startTransaction() override;
 
+		std::unique_ptr<ITableRecordSet> executePreparedTableQuery(const std::string& statementKey,
+																   const std::function<std::string()>& queryBuilder,
+																   const StatementParameters& parameters,
+																   ITable& table);
+		OperationResult executePreparedOperation(const std::string& statementKey,
+												 const std::function<std::string()>& operationBuilder,
+												 const StatementParameters& parameters);
+
+		// Streams, COPY writers, pipelines and large objects take the connection over until they are finished
+		// or destroyed, which must happen on the thread that created them. Meanwhile, any other statement
+		// issued through this database throws std::runtime_error
+		std::unique_ptr<CopyInWriter> startCopyIn(const std::string& tableName,
+												  const std::vector<const Field*>& columns,
+												  const CopyOptions& options);
+
+		// Streams the rows of the query as they arrive from COPY ... TO STDOUT, without materializing them.
+		// Each chunk is handed to the sink and only valid during the call. Returns the number of rows copied
+		RowsAffected copyOut(const std::string& query, const std::function<void(std::string_view)>& sink, CopyFormat format);
+		RowsAffected copyOut(const std::string& query, std::ostream& outputStream, CopyFormat format);
+		RowsAffected copyOut(const std::string& query, int fileDescriptor, CopyFormat format);
+
+		// The outcome of asynchronous operations is only available through the returned future, it isn't
+		// reflected by getRowsAffectedByLastChangeOperation or the last inserted row ids of any thread
+		std::future<std::unique_ptr<IRecordSet>> executeQueryAsync(AsyncReactor& reactor, const std::string& query);
+		std::future<RowsAffected> executeOperationAsync(AsyncReactor& reactor, const std::string& operation);
+
+		std::unique_ptr<Pipeline> startPipeline();
+		std::unique_ptr<Pipeline> startPipeline(unsigned int maxPendingStatements);
+
+		std::unique_ptr<LargeObject> createLargeObject();
+		std::unique_ptr<LargeObject> createLargeObject(std::size_t chunkSize);
+		std::unique_ptr<LargeObject> openLargeObject(unsigned int oid, LargeObjectMode mode);
+		std::unique_ptr<LargeObject> openLargeObject(unsigned int oid, LargeObjectMode mode, std::size_t chunkSize);
+		void unlinkLargeObject(unsigned int oid);
+
+		PreparedStatementCache::Statistics getPreparedStatementCacheStatistics() const;
+		void setPreparedStatementCacheCapacity(unsigned int capacity);
+
+		std::string getSchemaCacheKey();
+		void listenForSchemaChanges();
+		void installSchemaChangeTrigger();
+
+		bool isConnectionHealthy(bool ping);
+		bool resetSession();
+
+		ResultFormat getResultFormat() const;
+		void setResultFormat(ResultFormat resultFormat);
+
 	private:
+		// Each thread only observes the results of the synchronous operations it executed. Entries live in
+		// thread-local storage and are discarded once the database that recorded them is destroyed
+		struct LastOperation
+		{
+			std::weak_ptr<const void> database;
+			RowsAffected rowsAffected = 0;
+			std::int64_t insertedRowId = 0;
+			std::vector<std::int64_t> insertedRowIds;
+		};
+
 		PGconn* m_database;
-		std::map<std::string, std::unique_ptr<ITable>> m_tables;
-		std::recursive_mutex m_mutex;
-		RowsAffected m_lastOperationRowsAffected = 0;
-		RowId m_lastInsertedRowId = 0;
+		// Serializes the use of the connection
+		mutable ConnectionMutex m_mutex;
+		ConnectionState m_connectionState;
+		// Loaded tables are never removed, so references handed out stay valid without holding the lock. They
+		// are keyed by relation OID, and each name they have been requested with is kept as an alias
+		std::map<unsigned int, std::unique_ptr<ITable>> m_tables;
+		std::map<std::string, ITable*> m_tableNames;
+		mutable std::shared_mutex m_tablesMutex;
+		PreparedStatementCache m_preparedStatements;
+		std::atomic<bool> m_preparedStatementsStale = false;
+		std::atomic<ResultFormat> m_resultFormat = ResultFormat::TEXT;
+		std::string m_schemaCacheKey;
+		std::atomic<bool> m_listeningForSchemaChanges = false;
+		// Tells the last operations recorded by this database apart from those of a destroyed one at the same address
+		std::shared_ptr<const void> m_lifetimeToken;
+
+		ITable* findTable(const std::string& tableName) const;
+		ITable* findTable(unsigned int relationOID) const;
+		ITable& addTable(unsigned int relationOID, std::unique_ptr<ITable> table);
+		void addTableName(const std::string& tableName, ITable& table);
+		LastOperation getLastOperation() const;
+		void setLastOperation(const OperationResult& operationResult);
+		static std::unordered_map<const Database*, LastOperation>& getThreadLastOperations();
+
+		BusyConnectionLock lockBusyConnection();
+		PGresult* execute(const std::string& statement, ResultFormat resultFormat);
+		std::unique_ptr<ResultStream> executeStreaming(const std::string& query);
+		std::shared_ptr<const PGresult> executeRetained(const std::string& query);
+		PGresult* executePrepared(const std::string& statementKey,
+								  const std::function<std::string()>& statementBuilder,
+								  const StatementParameters& parameters,
+								  ResultFormat resultFormat);
+		PGresult* executeCachedStatement(const std::string& statementKey,
+										 const std::function<std::string()>& statementBuilder,
+										 const StatementParameters& parameters,
+										 ResultFormat resultFormat);
+		// Only decodes the result, so it can run on the reactor thread
+		static OperationResult processOperationResult(const PGresult* statementResult, std::chrono::steady_clock::time_point startTime);
+		void invalidateSchema(const std::string& schemaCacheKey);
+		void processSchemaChangeNotifications();
 	};
 }
\ No newline at end of file
@@ -6,13 +6,25 @@ namespace systelab::db::postgresql {
         bytearrayOID = 17,
         charOID = 18,
         nameOID = 19,
+        bigIntOID = 20,
         smallIntIOD = 21,
         intOID = 23,
         textOID = 25,
+        oidOID = 26,
+        jsonOID = 114,
+        xmlOID = 142,
         floatOID = 700,
         doubleOID = 701,
+        bpcharOID = 1042,
         varcharOID = 1043,
+        dateOID = 1082,
+        timeOID = 1083,
+        timestampOID = 1114,
         datetimeOID = 1184,
-        pidOID=2206
+        intervalOID = 1186,
+        numericOID = 1700,
+        pidOID=2206,
+        uuidOID = 2950,
+        jsonbOID = 3802
     };
 }
\ No newline at end of file
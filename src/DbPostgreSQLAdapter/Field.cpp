@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Field.h"
 
+#include "BinaryValue.h"
 #include "PostgresUtils.h"
 
 namespace systelab::db::postgresql {
@@ -9,15 +10,19 @@ namespace systelab::db::postgresql {
 				 const std::string& name,
 				 const FieldTypes type,
 				 const std::string& defaultValue,
-				 const bool primaryKey)
+				 const bool primaryKey,
+				 const PostgresqlOID typeOID)
 		: m_index(index)
 		, m_name(name)
 		, m_type(type)
 		, m_primaryKey(primaryKey)
+		, m_typeOID(typeOID)
 	{
 		setDefaultValue(type, defaultValue);
 	}
 
+	Field::~Field() = default;
+
 	unsigned int Field::getIndex() const
 	{
 		return m_index;
@@ -54,6 +59,11 @@ namespace systelab::db::postgresql {
 	}
 
 	int Field::getIntDefaultValue() const
+	{
+		return utils::toIntValue(getBigIntDefaultValue());
+	}
+
+	std::int64_t Field::getBigIntDefaultValue() const
 	{
 		if (hasNullDefaultValue())
 		{
@@ -115,7 +125,17 @@ namespace systelab::db::postgresql {
 
 	IBinaryValue& Field::getBinaryDefaultValue() const
 	{
-		throw std::runtime_error("Not implemented yet");
+		if (hasNullDefaultValue())
+		{
+			throw std::runtime_error("Default value is null");
+		}
+
+		if (m_type != BINARY)
+		{
+			throw std::runtime_error("Field type isn't binary");
+		}
+
+		return *m_defaultBinaryValue;
 	}
 
 	bool Field::isPrimaryKey() const
@@ -123,6 +143,11 @@ namespace systelab::db::postgresql {
 		return m_primaryKey;
 	}
 
+	PostgresqlOID Field::getTypeOID() const
+	{
+		return m_typeOID;
+	}
+
 	void Field::setDefaultValue(FieldTypes type, const std::string& defaultValue)
 	{
 		m_defaultBoolValue = false;
@@ -130,6 +155,7 @@ namespace systelab::db::postgresql {
 		m_defaultDoubleValue = 0.;
 		m_defaultStringValue = "";
 		m_defaultDateTimeValue = std::chrono::system_clock::time_point {};
+		m_defaultBinaryValue.reset();
 
 		std::string defaultValueUpper = defaultValue;
 		std::transform(defaultValueUpper.begin(), defaultValueUpper.end(), defaultValueUpper.begin(), ::toupper);
@@ -146,7 +172,7 @@ namespace systelab::db::postgresql {
 					m_defaultBoolValue = utils::isBooleanTrue(defaultValueUpper);
 					break;
 				case INT:
-					m_defaultIntValue = std::stoi(defaultValue);
+					m_defaultIntValue = std::stoll(defaultValue);
 					break;
 				case DOUBLE:
 					m_defaultDoubleValue = std::stod(defaultValue);
@@ -158,6 +184,12 @@ namespace systelab::db::postgresql {
 					m_defaultDateTimeValue = utils::stringISOToDateTime(defaultValue);
 					break;
 				case BINARY:
+				{
+					std::string defaultData;
+					utils::decodeByteaText(defaultValue, defaultData);
+					m_defaultBinaryValue = std::make_unique<BinaryValue>(std::move(defaultData));
+				}
+				break;
 				default:
 					throw std::runtime_error("Invalid record field type." );
 					break;
@@ -2,22 +2,29 @@
 
 #include "DbAdapterInterface/IField.h"
 
+#include "DefaultOID.h"
+
 namespace systelab::db::postgresql {
 
+	class BinaryValue;
+
 	class Field : public IField
 	{
 	public:
-		Field(const unsigned int index, const std::string& name, const FieldTypes type, const std::string& defaultValue, const bool primaryKey);
-		~Field() override = default;
+		Field(const unsigned int index, const std::string& name, const FieldTypes type, const std::string& defaultValue, const bool primaryKey,
+			  const PostgresqlOID typeOID);
+		~Field() override;
 
 		unsigned int getIndex() const override;
 		std::string getName() const override;
 		FieldTypes getType() const override;
 		bool isPrimaryKey() const override;
+		PostgresqlOID getTypeOID() const;
 
 		bool hasNullDefaultValue() const override;
 		bool getBooleanDefaultValue() const override;
 		int getIntDefaultValue() const override;
+		std::int64_t getBigIntDefaultValue() const;
 		double getDoubleDefaultValue() const override;
 		std::string getStringDefaultValue() const override;
 		std::chrono::system_clock::time_point getDateTimeDefaultValue() const override;
@@ -28,13 +35,15 @@ namespace systelab::db::postgresql {
 		std::string m_name;
 		FieldTypes m_type;
 		bool m_primaryKey;
+		PostgresqlOID m_typeOID;
 
 		bool m_nullDefaultValue;
 		bool m_defaultBoolValue;
-		int m_defaultIntValue;
+		std::int64_t m_defaultIntValue;
 		double m_defaultDoubleValue;
 		std::string m_defaultStringValue;
 		std::chrono::system_clock::time_point m_defaultDateTimeValue;
+		std::unique_ptr<BinaryValue> m_defaultBinaryValue;
 
 		void setDefaultValue(FieldTypes type, const std::string& defaultValue);
 	};
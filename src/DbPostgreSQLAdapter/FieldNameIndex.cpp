@@ -0,0 +1,30 @@
+#include "stdafx.h"
+#include "FieldNameIndex.h"
+
+#include "Table.h"
+
+namespace systelab::db::postgresql {
+
+	std::shared_ptr<const FieldNameIndex> FieldNameIndex::getTableIndex(const ITable& table)
+	{
+		const auto* postgresTable = dynamic_cast<const Table*>(&table);
+		return (postgresTable != nullptr) ? postgresTable->getFieldNameIndex() : nullptr;
+	}
+
+	void FieldNameIndex::add(const std::string& fieldName, unsigned int position)
+	{
+		// The first field with a repeated name wins, as with a sequential search
+		m_positions.emplace(fieldName, position);
+	}
+
+	std::optional<unsigned int> FieldNameIndex::find(const std::string& fieldName) const
+	{
+		const auto positionIterator = m_positions.find(fieldName);
+		if (positionIterator != m_positions.cend())
+		{
+			return positionIterator->second;
+		}
+
+		return std::nullopt;
+	}
+}
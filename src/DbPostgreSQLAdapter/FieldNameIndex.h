@@ -0,0 +1,38 @@
+#pragma once
+
+namespace systelab::db {
+	class ITable;
+}
+
+namespace systelab::db::postgresql {
+
+	// Maps field names to their position, built once per table or result and shared by its records
+	class FieldNameIndex
+	{
+	public:
+		FieldNameIndex() = default;
+		~FieldNameIndex() = default;
+
+		template<typename FieldPointers>
+		static std::shared_ptr<const FieldNameIndex> create(const FieldPointers& fields)
+		{
+			auto fieldNameIndex = std::make_shared<FieldNameIndex>();
+			unsigned int position = 0;
+			for (const auto& field : fields)
+			{
+				fieldNameIndex->add(field->getName(), position++);
+			}
+
+			return fieldNameIndex;
+		}
+
+		// Index of the table fields when the table belongs to this adapter, null otherwise
+		static std::shared_ptr<const FieldNameIndex> getTableIndex(const ITable& table);
+
+		void add(const std::string& fieldName, unsigned int position);
+		std::optional<unsigned int> find(const std::string& fieldName) const;
+
+	private:
+		std::unordered_map<std::string, unsigned int> m_positions;
+	};
+}
@@ -2,95 +2,95 @@
 #include "FieldValue.h"
 
 #include "DbAdapterInterface/IBinaryValue.h"
+#include "BinaryValue.h"
+#include "Field.h"
 #include "PostgresUtils.h"
 
 namespace systelab::db::postgresql {
 
 	FieldValue::FieldValue(const IField& field)
 		: m_field(field)
-		, m_nullValue(true)
-		, m_default(false)
-		, m_boolValue(false)
-		, m_intValue(0)
-		, m_doubleValue(0.)
-		, m_stringValue("")
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::NULL_VALUE)
+		, m_inlineStringSize(0)
 	{
 	}
 
 	FieldValue::FieldValue(const IField& field, bool value)
 		: m_field(field)
-		, m_nullValue(false)
-		, m_default(false)
-		, m_boolValue(value)
-		, m_intValue(0)
-		, m_doubleValue(0.)
-		, m_stringValue("")
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::VALUE)
+		, m_inlineStringSize(0)
 	{
 		if (m_field.getType() != BOOLEAN)
 		{
 			throw std::runtime_error("Field doesn't accept a boolean value");
 		}
+
+		m_value.boolValue = value;
 	}
 
 	FieldValue::FieldValue(const IField& field, int value)
 		: m_field(field)
-		, m_nullValue(false)
-		, m_default(false)
-		, m_boolValue(false)
-		, m_intValue(value)
-		, m_doubleValue(0.)
-		, m_stringValue("")
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::VALUE)
+		, m_inlineStringSize(0)
 	{
 		if (m_field.getType() != INT)
 		{
 			throw std::runtime_error("Field doesn't accept an integer value");
 		}
+
+		m_value.intValue = value;
+	}
+
+	FieldValue::FieldValue(const IField& field, std::int64_t value)
+		: m_field(field)
+		, m_value()
+		, m_state(State::VALUE)
+		, m_inlineStringSize(0)
+	{
+		if (m_field.getType() != INT)
+		{
+			throw std::runtime_error("Field doesn't accept an integer value");
+		}
+
+		m_value.intValue = value;
 	}
 
 	FieldValue::FieldValue(const IField& field, double value)
 		: m_field(field)
-		, m_nullValue(false)
-		, m_default(false)
-		, m_boolValue(false)
-		, m_intValue(0)
-		, m_doubleValue(value)
-		, m_stringValue("")
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::VALUE)
+		, m_inlineStringSize(0)
 	{
 		if (m_field.getType() != DOUBLE)
 		{
 			throw std::runtime_error("Field doesn't accept a double value");
 		}
+
+		m_value.doubleValue = value;
 	}
 
 	FieldValue::FieldValue(const IField& field, const std::string& value)
 		: m_field(field)
-		, m_nullValue(false)
-		, m_default(false)
-		, m_boolValue(false)
-		, m_intValue(0)
-		, m_doubleValue(0.)
-		, m_stringValue(value)
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::VALUE)
+		, m_inlineStringSize(0)
 	{
 		if (m_field.getType() != STRING)
 		{
 			throw std::runtime_error("Field doesn't accept a string value");
 		}
+
+		storeString(value);
 	}
 
 	FieldValue::FieldValue(const IField& field, const std::chrono::system_clock::time_point& value)
 		: m_field(field)
-		, m_nullValue(true)
-		, m_default(false)
-		, m_boolValue(false)
-		, m_intValue(0)
-		, m_doubleValue(0.)
-		, m_stringValue("")
-		, m_dateTimeValue()
+		, m_value()
+		, m_state(State::NULL_VALUE)
+		, m_inlineStringSize(0)
 	{
 		if (m_field.getType() != DATETIME)
 		{
@@ -99,12 +99,33 @@ namespace systelab::db::postgresql {
 
 		if (!utils::isDateTimeNull(value))
 		{
-			m_dateTimeValue = value;
-			m_nullValue = false;
+			m_value.dateTimeTicks = value.time_since_epoch().count();
+			m_state = State::VALUE;
 		}
 	}
 
-	FieldValue::~FieldValue() = default;
+	FieldValue::FieldValue(const IField& field, std::unique_ptr<IBinaryValue> value)
+		: m_field(field)
+		, m_value()
+		, m_state(State::NULL_VALUE)
+		, m_inlineStringSize(0)
+	{
+		if (m_field.getType() != BINARY)
+		{
+			throw std::runtime_error("Field doesn't accept a binary value");
+		}
+
+		if (value)
+		{
+			m_value.binaryValue = value.release();
+			m_state = State::VALUE;
+		}
+	}
+
+	FieldValue::~FieldValue()
+	{
+		resetValue(State::NULL_VALUE);
+	}
 
 	const IField& FieldValue::getField() const
 	{
@@ -113,12 +134,12 @@ namespace systelab::db::postgresql {
 
 	bool FieldValue::isNull() const
 	{
-		return m_nullValue;
+		return m_state == State::NULL_VALUE;
 	}
 
 	bool FieldValue::isDefault() const
 	{
-		return m_default;
+		return m_state == State::DEFAULT_VALUE;
 	}
 
 	bool FieldValue::getBooleanValue() const
@@ -138,10 +159,15 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't boolean");
 		}
 
-		return m_boolValue;
+		return m_value.boolValue;
 	}
 
 	int FieldValue::getIntValue() const
+	{
+		return utils::toIntValue(getBigIntValue());
+	}
+
+	std::int64_t FieldValue::getBigIntValue() const
 	{
 		if (isNull())
 		{
@@ -158,7 +184,7 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't integer");
 		}
 
-		return m_intValue;
+		return m_value.intValue;
 	}
 
 	double FieldValue::getDoubleValue() const
@@ -178,7 +204,7 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't double");
 		}
 
-		return m_doubleValue;
+		return m_value.doubleValue;
 	}
 
 	std::string FieldValue::getStringValue() const
@@ -198,7 +224,7 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't string");
 		}
 
-		return m_stringValue;
+		return std::string(getStoredString());
 	}
 
 	std::chrono::system_clock::time_point FieldValue::getDateTimeValue() const
@@ -210,7 +236,7 @@ namespace systelab::db::postgresql {
 
 		if (m_field.getType() == DATETIME)
 		{
-			return m_dateTimeValue;
+			return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(m_value.dateTimeTicks));
 		}
 
 		if (m_field.getType() != STRING)
@@ -220,7 +246,7 @@ namespace systelab::db::postgresql {
 
 		if (!isNull())
 		{
-			return utils::stringISOToDateTime(m_stringValue);
+			return utils::stringISOToDateTime(std::string(getStoredString()));
 		}
 		
 		return std::chrono::system_clock::time_point {};
@@ -228,7 +254,22 @@ namespace systelab::db::postgresql {
 
 	IBinaryValue& FieldValue::getBinaryValue() const
 	{
-		throw std::runtime_error("Not implemented yet");
+		if (isNull())
+		{
+			throw std::runtime_error("Field value is null");
+		}
+
+		if (isDefault())
+		{
+			throw std::runtime_error("Field value is default");
+		}
+
+		if (m_field.getType() != BINARY)
+		{
+			throw std::runtime_error("Field type isn't binary");
+		}
+
+		return *m_value.binaryValue;
 	}
 
 	void FieldValue::setValue(const IFieldValue& srcFieldValue)
@@ -255,7 +296,7 @@ namespace systelab::db::postgresql {
 					setBooleanValue(srcFieldValue.getBooleanValue());
 					break;
 				case INT:
-					setIntValue(srcFieldValue.getIntValue());
+					setBigIntValue(utils::getBigIntValue(srcFieldValue));
 					break;
 				case DOUBLE:
 					setDoubleValue(srcFieldValue.getDoubleValue());
@@ -267,7 +308,7 @@ namespace systelab::db::postgresql {
 					setDateTimeValue(srcFieldValue.getDateTimeValue());
 					break;
 				case BINARY:
-					throw std::runtime_error("Invalid record field type.");
+					setBinaryValue(BinaryValue::copy(srcFieldValue.getBinaryValue()));
 					break;
 			}
 		}
@@ -275,24 +316,12 @@ namespace systelab::db::postgresql {
 
 	void FieldValue::setNull()
 	{
-		m_nullValue = true;
-		m_default = false;
-		m_boolValue = false;
-		m_intValue = 0;
-		m_doubleValue = 0.;
-		m_stringValue = "";
-		m_dateTimeValue = std::chrono::system_clock::time_point {};
+		resetValue(State::NULL_VALUE);
 	}
 
 	void FieldValue::setDefault()
 	{
-		m_nullValue = false;
-		m_default = true;
-		m_boolValue = false;
-		m_intValue = 0;
-		m_doubleValue = 0.;
-		m_stringValue = "";
-		m_dateTimeValue = std::chrono::system_clock::time_point {};
+		resetValue(State::DEFAULT_VALUE);
 	}
 
 	void FieldValue::setBooleanValue(bool value)
@@ -302,21 +331,24 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't boolean");
 		}
 
-		m_boolValue = value;
-		m_nullValue = false;
-		m_default = false;
+		resetValue(State::VALUE);
+		m_value.boolValue = value;
 	}
 
 	void FieldValue::setIntValue(int value)
+	{
+		setBigIntValue(value);
+	}
+
+	void FieldValue::setBigIntValue(std::int64_t value)
 	{
 		if (m_field.getType() != INT)
 		{
 			throw std::runtime_error("Field type isn't integer");
 		}
 		
-		m_intValue = value;
-		m_nullValue = false;
-		m_default = false;
+		resetValue(State::VALUE);
+		m_value.intValue = value;
 	}
 
 	void FieldValue::setDoubleValue(double value)
@@ -326,9 +358,8 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't double");
 		}
 
-		m_doubleValue = value;
-		m_nullValue = false;
-		m_default = false;
+		resetValue(State::VALUE);
+		m_value.doubleValue = value;
 	}
 
 	void FieldValue::setStringValue(const std::string& value)
@@ -338,9 +369,8 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't string");
 		}
 		
-		m_stringValue = value;
-		m_nullValue = false;
-		m_default = false;
+		resetValue(State::VALUE);
+		storeString(value);
 	}
 
 	void FieldValue::setDateTimeValue(const std::chrono::system_clock::time_point& value)
@@ -350,14 +380,19 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Field type isn't datetime");
 		}
 		
-		m_dateTimeValue = value;
-		m_nullValue = utils::isDateTimeNull(value);
-		m_default = false;
+		resetValue(utils::isDateTimeNull(value) ? State::NULL_VALUE : State::VALUE);
+		m_value.dateTimeTicks = value.time_since_epoch().count();
 	}
 
 	void FieldValue::setBinaryValue(std::unique_ptr<IBinaryValue> value)
 	{
-		throw std::runtime_error("Not implemented yet");
+		if (m_field.getType() != BINARY)
+		{
+			throw std::runtime_error("Field type isn't binary");
+		}
+
+		resetValue(value ? State::VALUE : State::NULL_VALUE);
+		m_value.binaryValue = value.release();
 	}
 
 	void FieldValue::useDefaultValue()
@@ -370,8 +405,11 @@ namespace systelab::db::postgresql {
 				break;
 
 			case INT:
-				setIntValue(m_field.getIntDefaultValue());
-				break;
+			{
+				const auto* field = dynamic_cast<const Field*>(&m_field);
+				setBigIntValue(field ? field->getBigIntDefaultValue() : m_field.getIntDefaultValue());
+			}
+			break;
 
 			case DOUBLE:
 				setDoubleValue(m_field.getDoubleDefaultValue());
@@ -386,6 +424,9 @@ namespace systelab::db::postgresql {
 				break;
 
 			case BINARY:
+				setBinaryValue(BinaryValue::copy(m_field.getBinaryDefaultValue()));
+				break;
+
 			default:
 				throw std::runtime_error("Invalid field type.");
 				break;
@@ -410,24 +451,89 @@ namespace systelab::db::postgresql {
 		switch (fieldType)
 		{
 			case BOOLEAN:
-				return std::make_unique<FieldValue>(m_field, m_boolValue);
+				return std::make_unique<FieldValue>(m_field, m_value.boolValue);
 
 			case INT:
-				return std::make_unique<FieldValue>(m_field, m_intValue);
+				return std::make_unique<FieldValue>(m_field, m_value.intValue);
 
 			case DOUBLE:
-				return std::make_unique<FieldValue>(m_field, m_doubleValue);
+				return std::make_unique<FieldValue>(m_field, m_value.doubleValue);
 
 			case STRING:
-				return std::make_unique<FieldValue>(m_field, m_stringValue);
+				return std::make_unique<FieldValue>(m_field, std::string(getStoredString()));
 
 			case DATETIME:
-				return std::make_unique<FieldValue>(m_field, m_dateTimeValue);
+				return std::make_unique<FieldValue>(m_field, getDateTimeValue());
 
 			case BINARY:
+				return std::make_unique<FieldValue>(m_field, BinaryValue::copy(*m_value.binaryValue));
+
 			default:
 				throw std::runtime_error("Invalid field type.");
 				break;
 		}
 	}
-}
\ No newline at end of file
+
+	std::string_view FieldValue::getStoredString() const
+	{
+		if (m_inlineStringSize == HEAP_STRING_SIZE)
+		{
+			return std::string_view(m_value.heapString.data, m_value.heapString.size);
+		}
+
+		return std::string_view(m_value.inlineString, m_inlineStringSize);
+	}
+
+	void FieldValue::storeString(std::string_view value)
+	{
+		if (value.size() <= INLINE_STRING_CAPACITY)
+		{
+			std::copy(value.begin(), value.end(), m_value.inlineString);
+			m_inlineStringSize = static_cast<std::uint8_t>(value.size());
+		}
+		else
+		{
+			m_value.heapString.data = new char[value.size()];
+			m_value.heapString.size = value.size();
+			std::copy(value.begin(), value.end(), m_value.heapString.data);
+			m_inlineStringSize = HEAP_STRING_SIZE;
+		}
+	}
+
+	void FieldValue::resetValue(State state)
+	{
+		if (m_inlineStringSize == HEAP_STRING_SIZE)
+		{
+			delete[] m_value.heapString.data;
+		}
+		else if (m_state == State::VALUE && m_field.getType() == BINARY)
+		{
+			delete m_value.binaryValue;
+		}
+
+		m_value = Value();
+		m_state = state;
+		m_inlineStringSize = 0;
+	}
+
+	namespace utils {
+		std::int64_t getBigIntValue(const IFieldValue& fieldValue)
+		{
+			const auto* postgresFieldValue = dynamic_cast<const FieldValue*>(&fieldValue);
+			return postgresFieldValue ? postgresFieldValue->getBigIntValue() : fieldValue.getIntValue();
+		}
+
+		void setBigIntValue(IFieldValue& fieldValue, std::int64_t value)
+		{
+			auto* postgresFieldValue = dynamic_cast<FieldValue*>(&fieldValue);
+			if (postgresFieldValue)
+			{
+				postgresFieldValue->setBigIntValue(value);
+			}
+			else
+			{
+				fieldValue.setIntValue(toIntValue(value));
+			}
+		}
+	}
+}
@@ -16,9 +16,11 @@ namespace systelab::db::postgresql {
 		FieldValue(const IField&);
 		explicit FieldValue(const IField&, bool);
 		FieldValue(const IField&, int);
+		FieldValue(const IField&, std::int64_t);
 		FieldValue(const IField&, double);
 		FieldValue(const IField&, const std::string&);
 		FieldValue(const IField&, const std::chrono::system_clock::time_point&);
+		FieldValue(const IField&, std::unique_ptr<IBinaryValue>);
 		~FieldValue(void) override;
 
 		const IField& getField() const override;
@@ -27,6 +29,7 @@ namespace systelab::db::postgresql {
 		bool isDefault() const override;
 		bool getBooleanValue() const override;
 		int getIntValue() const override;
+		std::int64_t getBigIntValue() const;
 		double getDoubleValue() const override;
 		std::string getStringValue() const override;
 		std::chrono::system_clock::time_point getDateTimeValue() const override;
@@ -37,6 +40,7 @@ namespace systelab::db::postgresql {
 		void setDefault();
 		void setBooleanValue(bool value) override;
 		void setIntValue(int value) override;
+		void setBigIntValue(std::int64_t value);
 		void setDoubleValue(double value) override;
 		void setStringValue(const std::string& value) override;
 		void setDateTimeValue(const std::chrono::system_clock::time_point& value) override;
@@ -47,14 +51,53 @@ namespace systelab::db::postgresql {
 		std::unique_ptr<IFieldValue> clone() const;
 
 	private:
+		enum class State : std::uint8_t
+		{
+			VALUE = 0,
+			NULL_VALUE = 1,
+			DEFAULT_VALUE = 2
+		};
+
+		static constexpr std::size_t INLINE_STRING_CAPACITY = 16;
+		static constexpr std::uint8_t HEAP_STRING_SIZE = 0xFF;
+
+		// Only the member matching the field type is active, strings longer than the inline capacity live on the heap
+		// and binary values are owned through the pointer
+		union Value
+		{
+			bool boolValue;
+			std::int64_t intValue;
+			double doubleValue;
+			std::chrono::system_clock::rep dateTimeTicks;
+			IBinaryValue* binaryValue;
+			struct
+			{
+				char* data;
+				std::size_t size;
+			} heapString;
+			char inlineString[INLINE_STRING_CAPACITY];
+		};
+
+		// Records keep one FieldValue per column, so the inline buffer is sized to add nothing over the 64-bit and
+		// heap string members it shares the union with
+		static_assert(sizeof(Value) == INLINE_STRING_CAPACITY, "The inline string buffer must not enlarge the value union");
+
 		const IField& m_field;
+		Value m_value;
+		State m_state;
+		std::uint8_t m_inlineStringSize;
+
+		FieldValue(const FieldValue&) = delete;
+		FieldValue& operator=(const FieldValue&) = delete;
 
-		bool m_nullValue;
-		bool m_default;
-		bool m_boolValue;
-		int m_intValue;
-		double m_doubleValue;
-		std::string m_stringValue;
-		std::chrono::system_clock::time_point m_dateTimeValue;
+		std::string_view getStoredString() const;
+		void storeString(std::string_view value);
+		void resetValue(State state);
 	};
+
+	namespace utils {
+		// Integer access that keeps the full 64-bit range when the value is one of the adapter's own
+		std::int64_t getBigIntValue(const IFieldValue& fieldValue);
+		void setBigIntValue(IFieldValue& fieldValue, std::int64_t value);
+	}
 }
\ No newline at end of file
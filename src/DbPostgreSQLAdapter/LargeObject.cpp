@@ -0,0 +1,169 @@
+#include "stdafx.h"
+#include "LargeObject.h"
+
+#include "LargeObjectStreamBuffer.h"
+#include "PostgresUtils.h"
+
+namespace systelab::db::postgresql {
+
+	LargeObject::LargeObject(PGconn* connection, BusyConnectionLock lock,
+							 unsigned int oid, LargeObjectMode mode, std::size_t chunkSize)
+		: m_connection(connection)
+		, m_lock(std::move(lock))
+		, m_oid(oid)
+		, m_mode(mode)
+		, m_ownsTransaction(false)
+		, m_descriptor(-1)
+	{
+		const PGTransactionStatusType transactionStatus = PQtransactionStatus(m_connection);
+		if (transactionStatus == PQTRANS_IDLE)
+		{
+			executeTransactionCommand("BEGIN");
+			m_ownsTransaction = true;
+		}
+		else if (transactionStatus != PQTRANS_INTRANS)
+		{
+			throw std::runtime_error("Large objects can't be opened while the connection is busy or its transaction failed");
+		}
+
+		try
+		{
+			if (m_oid == NEW_OBJECT)
+			{
+				m_oid = lo_create(m_connection, InvalidOid);
+				if (m_oid == InvalidOid)
+				{
+					throw std::runtime_error(std::string("Unable to create large object: ") + PQerrorMessage(m_connection));
+				}
+			}
+
+			m_descriptor = lo_open(m_connection, m_oid, (m_mode == LargeObjectMode::READ_WRITE) ? (INV_READ | INV_WRITE) : INV_READ);
+			if (m_descriptor < 0)
+			{
+				throw std::runtime_error(std::string("Unable to open large object: ") + PQerrorMessage(m_connection));
+			}
+
+			m_streamBuffer = std::make_unique<LargeObjectStreamBuffer>(m_connection, m_descriptor, chunkSize);
+		}
+		catch (...)
+		{
+			abort();
+			throw;
+		}
+	}
+
+	LargeObject::~LargeObject()
+	{
+		if (m_lock.ownsLock())
+		{
+			abort();
+		}
+	}
+
+	unsigned int LargeObject::getOID() const
+	{
+		return m_oid;
+	}
+
+	std::int64_t LargeObject::getSize() const
+	{
+		if (!m_lock.ownsLock())
+		{
+			throw std::runtime_error("Large object is closed");
+		}
+
+		const auto position = m_streamBuffer->pubseekoff(0, std::ios::cur);
+		const pg_int64 size = lo_lseek64(m_connection, m_descriptor, 0, SEEK_END);
+		m_streamBuffer->pubseekpos(position);
+		if (size < 0)
+		{
+			throw std::runtime_error(std::string("Unable to seek large object: ") + PQerrorMessage(m_connection));
+		}
+
+		return size;
+	}
+
+	std::ostream LargeObject::getOutputStream() const
+	{
+		if (!m_lock.ownsLock())
+		{
+			throw std::runtime_error("Large object is closed");
+		}
+
+		if (m_mode != LargeObjectMode::READ_WRITE)
+		{
+			throw std::runtime_error("Large object is opened for reading only");
+		}
+
+		m_streamBuffer->pubseekoff(0, std::ios::end, std::ios::out);
+		return std::ostream(m_streamBuffer.get());
+	}
+
+	std::istream LargeObject::getInputStream() const
+	{
+		if (!m_lock.ownsLock())
+		{
+			throw std::runtime_error("Large object is closed");
+		}
+
+		m_streamBuffer->pubseekpos(0, std::ios::in);
+		return std::istream(m_streamBuffer.get());
+	}
+
+	void LargeObject::close()
+	{
+		if (!m_lock.ownsLock())
+		{
+			return;
+		}
+
+		try
+		{
+			m_streamBuffer->pubsync();
+			if (lo_close(m_connection, m_descriptor) != 0)
+			{
+				throw std::runtime_error(std::string("Unable to close large object: ") + PQerrorMessage(m_connection));
+			}
+			m_descriptor = -1;
+
+			if (m_ownsTransaction)
+			{
+				executeTransactionCommand("COMMIT");
+				m_ownsTransaction = false;
+			}
+		}
+		catch (...)
+		{
+			abort();
+			throw;
+		}
+
+		m_lock.unlock();
+	}
+
+	void LargeObject::executeTransactionCommand(const char* command)
+	{
+		const auto commandResult = utils::createRAIIPGresult(PQexec(m_connection, command));
+		if (PQresultStatus(commandResult.get()) != PGRES_COMMAND_OK)
+		{
+			utils::throwPostgressException(commandResult.get());
+		}
+	}
+
+	void LargeObject::abort()
+	{
+		// Rolling back closes the descriptor too. Pending writes are discarded either way
+		if (m_ownsTransaction)
+		{
+			PQclear(PQexec(m_connection, "ROLLBACK"));
+			m_ownsTransaction = false;
+		}
+		else if (m_descriptor >= 0)
+		{
+			lo_close(m_connection, m_descriptor);
+		}
+
+		m_descriptor = -1;
+		m_lock.unlock();
+	}
+}
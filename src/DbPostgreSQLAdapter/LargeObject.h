@@ -0,0 +1,50 @@
+#pragma once
+
+#include "DbAdapterInterface/IBinaryValue.h"
+
+#include "BusyConnectionLock.h"
+#include "LargeObjectMode.h"
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db::postgresql {
+
+	class LargeObjectStreamBuffer;
+
+	// Open large object whose contents are streamed from and to the server in bounded chunks. Input streams
+	// read it from the start and output streams append to it. Large objects can only be used inside a
+	// transaction: when none is in progress one is started for the object, committed by close and rolled
+	// back if the object is destroyed without closing it. The connection is kept locked and busy until then,
+	// so the object must be used, closed and destroyed on the thread that created it.
+	class LargeObject : public IBinaryValue
+	{
+	public:
+		static constexpr std::size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+		// Passed as OID to create a new large object
+		static constexpr unsigned int NEW_OBJECT = 0;
+
+		LargeObject(PGconn* connection, BusyConnectionLock lock,
+					unsigned int oid, LargeObjectMode mode, std::size_t chunkSize);
+		~LargeObject() override;
+
+		unsigned int getOID() const;
+		std::int64_t getSize() const;
+
+		std::ostream getOutputStream() const override;
+		std::istream getInputStream() const override;
+
+		void close();
+
+	private:
+		PGconn* m_connection;
+		BusyConnectionLock m_lock;
+		unsigned int m_oid;
+		LargeObjectMode m_mode;
+		bool m_ownsTransaction;
+		int m_descriptor;
+		std::unique_ptr<LargeObjectStreamBuffer> m_streamBuffer;
+
+		void executeTransactionCommand(const char* command);
+		void abort();
+	};
+}
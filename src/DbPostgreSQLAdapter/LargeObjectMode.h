@@ -0,0 +1,8 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+	enum class LargeObjectMode {
+		READ = 0,
+		READ_WRITE = 1
+	};
+}
\ No newline at end of file
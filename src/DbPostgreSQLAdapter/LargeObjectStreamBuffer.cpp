@@ -0,0 +1,172 @@
+#include "stdafx.h"
+#include "LargeObjectStreamBuffer.h"
+
+namespace systelab::db::postgresql {
+
+	LargeObjectStreamBuffer::LargeObjectStreamBuffer(PGconn* connection, int descriptor, std::size_t chunkSize)
+		: m_connection(connection)
+		, m_descriptor(descriptor)
+		, m_buffer(std::make_unique_for_overwrite<char[]>(chunkSize))
+		, m_chunkSize(chunkSize)
+	{
+		if (chunkSize == 0)
+		{
+			throw std::runtime_error("Large object chunk size can't be zero");
+		}
+	}
+
+	LargeObjectStreamBuffer::int_type LargeObjectStreamBuffer::underflow()
+	{
+		flushPutArea();
+		if (gptr() < egptr())
+		{
+			return traits_type::to_int_type(*gptr());
+		}
+
+		const std::size_t readSize = readChunk(m_buffer.get(), m_chunkSize);
+		if (readSize == 0)
+		{
+			setg(nullptr, nullptr, nullptr);
+			return traits_type::eof();
+		}
+
+		setg(m_buffer.get(), m_buffer.get(), m_buffer.get() + readSize);
+		return traits_type::to_int_type(*gptr());
+	}
+
+	LargeObjectStreamBuffer::int_type LargeObjectStreamBuffer::overflow(int_type character)
+	{
+		discardGetArea();
+		flushPutArea();
+		setp(m_buffer.get(), m_buffer.get() + m_chunkSize);
+		if (!traits_type::eq_int_type(character, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(character);
+			pbump(1);
+		}
+
+		return traits_type::not_eof(character);
+	}
+
+	std::streamsize LargeObjectStreamBuffer::xsgetn(char* data, std::streamsize count)
+	{
+		flushPutArea();
+
+		// Buffered data goes first, then large remainders are read without passing through the buffer
+		const std::streamsize bufferedSize = std::min<std::streamsize>(count, egptr() - gptr());
+		std::copy(gptr(), gptr() + bufferedSize, data);
+		gbump(static_cast<int>(bufferedSize));
+
+		std::streamsize copiedSize = bufferedSize;
+		while (count - copiedSize >= static_cast<std::streamsize>(m_chunkSize))
+		{
+			const std::size_t readSize = readChunk(data + copiedSize, m_chunkSize);
+			if (readSize == 0)
+			{
+				return copiedSize;
+			}
+
+			copiedSize += static_cast<std::streamsize>(readSize);
+		}
+
+		if (copiedSize < count)
+		{
+			copiedSize += std::streambuf::xsgetn(data + copiedSize, count - copiedSize);
+		}
+
+		return copiedSize;
+	}
+
+	std::streamsize LargeObjectStreamBuffer::xsputn(const char* data, std::streamsize count)
+	{
+		if (count < static_cast<std::streamsize>(m_chunkSize))
+		{
+			return std::streambuf::xsputn(data, count);
+		}
+
+		discardGetArea();
+		flushPutArea();
+		for (std::streamsize writtenSize = 0; writtenSize < count; writtenSize += static_cast<std::streamsize>(m_chunkSize))
+		{
+			writeChunk(data + writtenSize, std::min<std::size_t>(m_chunkSize, static_cast<std::size_t>(count - writtenSize)));
+		}
+
+		return count;
+	}
+
+	int LargeObjectStreamBuffer::sync()
+	{
+		flushPutArea();
+		return 0;
+	}
+
+	LargeObjectStreamBuffer::pos_type LargeObjectStreamBuffer::seekoff(off_type offset, std::ios::seekdir direction, std::ios::openmode)
+	{
+		flushPutArea();
+		if (direction == std::ios::cur)
+		{
+			// The server position is ahead of the stream by the data still buffered for reading
+			offset -= static_cast<off_type>(egptr() - gptr());
+		}
+		setg(nullptr, nullptr, nullptr);
+
+		const int whence = (direction == std::ios::beg) ? SEEK_SET : ((direction == std::ios::cur) ? SEEK_CUR : SEEK_END);
+		const pg_int64 position = lo_lseek64(m_connection, m_descriptor, static_cast<pg_int64>(offset), whence);
+		if (position < 0)
+		{
+			return pos_type(off_type(-1));
+		}
+
+		return pos_type(static_cast<off_type>(position));
+	}
+
+	LargeObjectStreamBuffer::pos_type LargeObjectStreamBuffer::seekpos(pos_type position, std::ios::openmode which)
+	{
+		return seekoff(off_type(position), std::ios::beg, which);
+	}
+
+	std::size_t LargeObjectStreamBuffer::readChunk(char* data, std::size_t size)
+	{
+		const int readSize = lo_read(m_connection, m_descriptor, data, size);
+		if (readSize < 0)
+		{
+			throw std::runtime_error(std::string("Unable to read large object: ") + PQerrorMessage(m_connection));
+		}
+
+		return static_cast<std::size_t>(readSize);
+	}
+
+	void LargeObjectStreamBuffer::writeChunk(const char* data, std::size_t size)
+	{
+		if (lo_write(m_connection, m_descriptor, data, size) != static_cast<int>(size))
+		{
+			throw std::runtime_error(std::string("Unable to write large object: ") + PQerrorMessage(m_connection));
+		}
+	}
+
+	void LargeObjectStreamBuffer::flushPutArea()
+	{
+		if (pbase() == nullptr)
+		{
+			return;
+		}
+
+		const char* pendingData = pbase();
+		const std::size_t pendingSize = static_cast<std::size_t>(pptr() - pbase());
+		setp(nullptr, nullptr);
+		if (pendingSize > 0)
+		{
+			writeChunk(pendingData, pendingSize);
+		}
+	}
+
+	void LargeObjectStreamBuffer::discardGetArea()
+	{
+		const off_type unreadSize = static_cast<off_type>(egptr() - gptr());
+		setg(nullptr, nullptr, nullptr);
+		if (unreadSize > 0 && lo_lseek64(m_connection, m_descriptor, -static_cast<pg_int64>(unreadSize), SEEK_CUR) < 0)
+		{
+			throw std::runtime_error(std::string("Unable to seek large object: ") + PQerrorMessage(m_connection));
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db::postgresql {
+
+	// Stream buffer over an open large object descriptor. Data is read and written through a buffer of
+	// a fixed size, and requests larger than the buffer go straight to the server in chunks of that size,
+	// so memory doesn't grow with the size of the object
+	class LargeObjectStreamBuffer : public std::streambuf
+	{
+	public:
+		LargeObjectStreamBuffer(PGconn* connection, int descriptor, std::size_t chunkSize);
+		~LargeObjectStreamBuffer() override = default;
+
+	protected:
+		int_type underflow() override;
+		int_type overflow(int_type character) override;
+		std::streamsize xsgetn(char* data, std::streamsize count) override;
+		std::streamsize xsputn(const char* data, std::streamsize count) override;
+		int sync() override;
+		pos_type seekoff(off_type offset, std::ios::seekdir direction, std::ios::openmode which) override;
+		pos_type seekpos(pos_type position, std::ios::openmode which) override;
+
+	private:
+		PGconn* m_connection;
+		int m_descriptor;
+		std::unique_ptr<char[]> m_buffer;
+		std::size_t m_chunkSize;
+
+		std::size_t readChunk(char* data, std::size_t size);
+		void writeChunk(const char* data, std::size_t size);
+		void flushPutArea();
+		void discardGetArea();
+	};
+}
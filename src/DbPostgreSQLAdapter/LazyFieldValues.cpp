@@ -0,0 +1,35 @@
+#include "stdafx.h"
+#include "LazyFieldValues.h"
+
+#include "ResultDecoder.h"
+
+#include "DbAdapterInterface/IField.h"
+#include "DbAdapterInterface/IFieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	LazyFieldValues::LazyFieldValues(std::shared_ptr<const PGresult> statementResult, int rowIndex, unsigned int fieldsCount)
+		: m_statementResult(std::move(statementResult))
+		, m_rowIndex(rowIndex)
+		, m_fieldsCount(fieldsCount)
+	{
+	}
+
+	LazyFieldValues::~LazyFieldValues() = default;
+
+	IFieldValue& LazyFieldValues::getFieldValue(const IField& field, unsigned int index) const
+	{
+		if (m_fieldValues.empty())
+		{
+			m_fieldValues.resize(m_fieldsCount);
+		}
+
+		std::unique_ptr<IFieldValue>& fieldValue = m_fieldValues.at(index);
+		if (!fieldValue)
+		{
+			fieldValue = utils::decodeFieldValue(field, m_statementResult.get(), m_rowIndex, field.getIndex());
+		}
+
+		return *fieldValue;
+	}
+}
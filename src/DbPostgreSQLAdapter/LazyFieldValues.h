@@ -0,0 +1,27 @@
+#pragma once
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db {
+	class IField;
+	class IFieldValue;
+}
+
+namespace systelab::db::postgresql {
+
+	// Decodes the values of a result row on first access and keeps them cached
+	class LazyFieldValues
+	{
+	public:
+		LazyFieldValues(std::shared_ptr<const PGresult> statementResult, int rowIndex, unsigned int fieldsCount);
+		~LazyFieldValues();
+
+		IFieldValue& getFieldValue(const IField& field, unsigned int index) const;
+
+	private:
+		std::shared_ptr<const PGresult> m_statementResult;
+		int m_rowIndex;
+		unsigned int m_fieldsCount;
+		mutable std::vector<std::unique_ptr<IFieldValue>> m_fieldValues;
+	};
+}
@@ -0,0 +1,61 @@
+#include "stdafx.h"
+#include "LazyRecord.h"
+
+#include "DbAdapterInterface/IField.h"
+#include "DbAdapterInterface/IRecordSet.h"
+
+namespace systelab::db::postgresql {
+
+	LazyRecord::LazyRecord(const IRecordSet& recordSet, std::shared_ptr<const PGresult> statementResult, const int rowIndex,
+						   const FieldNameIndex* fieldNameIndex)
+		: m_recordSet(recordSet)
+		, m_fieldValues(std::move(statementResult), rowIndex, recordSet.getFieldsCount())
+		, m_fieldNameIndex(fieldNameIndex)
+	{
+	}
+
+	unsigned int LazyRecord::getFieldValuesCount() const
+	{
+		return m_recordSet.getFieldsCount();
+	}
+
+	IFieldValue& LazyRecord::getFieldValue(unsigned int index) const
+	{
+		return m_fieldValues.getFieldValue(m_recordSet.getField(index), index);
+	}
+
+	IFieldValue& LazyRecord::getFieldValue(const std::string& fieldName) const
+	{
+		const auto fieldIndex = findFieldIndex(fieldName);
+		if (fieldIndex)
+		{
+			return getFieldValue(*fieldIndex);
+		}
+
+		throw std::runtime_error("The requested field value doesn't exist");
+	}
+
+	bool LazyRecord::hasFieldValue(const std::string& fieldName) const
+	{
+		return findFieldIndex(fieldName).has_value();
+	}
+
+	std::optional<unsigned int> LazyRecord::findFieldIndex(const std::string& fieldName) const
+	{
+		if (m_fieldNameIndex != nullptr)
+		{
+			return m_fieldNameIndex->find(fieldName);
+		}
+
+		const unsigned int fieldsCount = m_recordSet.getFieldsCount();
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			if (m_recordSet.getField(i).getName() == fieldName)
+			{
+				return i;
+			}
+		}
+
+		return std::nullopt;
+	}
+}
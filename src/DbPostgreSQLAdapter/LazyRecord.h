@@ -0,0 +1,36 @@
+#pragma once
+
+#include "DbAdapterInterface/IRecord.h"
+
+#include "FieldNameIndex.h"
+#include "LazyFieldValues.h"
+
+namespace systelab::db {
+	class IFieldValue;
+	class IRecordSet;
+}
+
+namespace systelab::db::postgresql {
+
+	class LazyRecord : public IRecord
+	{
+	public:
+		// Name lookups scan the record set fields when no index is given
+		LazyRecord(const IRecordSet& recordSet, std::shared_ptr<const PGresult> statementResult, const int rowIndex,
+				   const FieldNameIndex* fieldNameIndex = nullptr);
+		~LazyRecord() override = default;
+
+		unsigned int getFieldValuesCount() const override;
+		IFieldValue& getFieldValue(unsigned int index) const override;
+		IFieldValue& getFieldValue(const std::string& fieldName) const override;
+
+		bool hasFieldValue(const std::string& fieldName) const override;
+
+	private:
+		const IRecordSet& m_recordSet;
+		LazyFieldValues m_fieldValues;
+		const FieldNameIndex* m_fieldNameIndex;
+
+		std::optional<unsigned int> findFieldIndex(const std::string& fieldName) const;
+	};
+}
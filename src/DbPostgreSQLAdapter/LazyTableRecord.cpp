@@ -0,0 +1,82 @@
+#include "stdafx.h"
+#include "LazyTableRecord.h"
+
+#include "DbAdapterInterface/IField.h"
+#include "DbAdapterInterface/ITableRecordSet.h"
+
+namespace systelab::db::postgresql {
+
+	LazyTableRecord::LazyTableRecord(const ITableRecordSet& recordSet, std::shared_ptr<const PGresult> statementResult, const int rowIndex,
+									 const FieldNameIndex* fieldNameIndex)
+		: m_recordSet(recordSet)
+		, m_fieldValues(std::move(statementResult), rowIndex, recordSet.getFieldsCount())
+		, m_fieldNameIndex(fieldNameIndex)
+	{
+	}
+
+	ITable& LazyTableRecord::getTable() const
+	{
+		return m_recordSet.getTable();
+	}
+
+	unsigned int LazyTableRecord::getFieldValuesCount() const
+	{
+		return m_recordSet.getFieldsCount();
+	}
+
+	IFieldValue& LazyTableRecord::getFieldValue(unsigned int index) const
+	{
+		return m_fieldValues.getFieldValue(m_recordSet.getField(index), index);
+	}
+
+	IFieldValue& LazyTableRecord::getFieldValue(const std::string& fieldName) const
+	{
+		const auto fieldIndex = findFieldIndex(fieldName);
+		if (fieldIndex)
+		{
+			return getFieldValue(*fieldIndex);
+		}
+
+		throw std::runtime_error("The requested field value doesn't exist");
+	}
+
+	bool LazyTableRecord::hasFieldValue(const std::string& fieldName) const
+	{
+		return findFieldIndex(fieldName).has_value();
+	}
+
+	std::vector<IFieldValue*> LazyTableRecord::getValuesList() const
+	{
+		std::vector<IFieldValue*> values;
+		const unsigned int fieldsCount = m_recordSet.getFieldsCount();
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			const IField& field = m_recordSet.getField(i);
+			if (!field.isPrimaryKey())
+			{
+				values.push_back(&m_fieldValues.getFieldValue(field, i));
+			}
+		}
+
+		return values;
+	}
+
+	std::optional<unsigned int> LazyTableRecord::findFieldIndex(const std::string& fieldName) const
+	{
+		if (m_fieldNameIndex != nullptr)
+		{
+			return m_fieldNameIndex->find(fieldName);
+		}
+
+		const unsigned int fieldsCount = m_recordSet.getFieldsCount();
+		for (unsigned int i = 0; i < fieldsCount; i++)
+		{
+			if (m_recordSet.getField(i).getName() == fieldName)
+			{
+				return i;
+			}
+		}
+
+		return std::nullopt;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DbAdapterInterface/ITableRecord.h"
+
+#include "FieldNameIndex.h"
+#include "LazyFieldValues.h"
+
+namespace systelab::db {
+	class ITableRecordSet;
+}
+
+namespace systelab::db::postgresql {
+
+	class LazyTableRecord : public ITableRecord
+	{
+	public:
+		// Name lookups scan the record set fields when no index is given
+		LazyTableRecord(const ITableRecordSet& recordSet, std::shared_ptr<const PGresult> statementResult, const int rowIndex,
+						const FieldNameIndex* fieldNameIndex = nullptr);
+		~LazyTableRecord() override = default;
+
+		ITable& getTable() const override;
+
+		unsigned int getFieldValuesCount() const override;
+		IFieldValue& getFieldValue(unsigned int index) const override;
+		IFieldValue& getFieldValue(const std::string& fieldName) const override;
+
+		bool hasFieldValue(const std::string& fieldName) const override;
+
+		std::vector<IFieldValue*> getValuesList() const override;
+
+	private:
+		const ITableRecordSet& m_recordSet;
+		LazyFieldValues m_fieldValues;
+		const FieldNameIndex* m_fieldNameIndex;
+
+		std::optional<unsigned int> findFieldIndex(const std::string& fieldName) const;
+	};
+}
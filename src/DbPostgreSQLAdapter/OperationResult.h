@@ -0,0 +1,17 @@
+#pragma once
+
+#include "DbAdapterInterface/Types.h"
+
+namespace systelab::db::postgresql {
+
+	// Outcome of a single change operation, returned to the caller that executed it
+	struct OperationResult
+	{
+		RowsAffected rowsAffected = 0;
+		// First column of the rows returned by the operation, as with RETURNING id
+		std::vector<std::int64_t> returnedKeys;
+		// Command status reported by the server, like "INSERT 0 1"
+		std::string commandTag;
+		std::chrono::steady_clock::duration duration{};
+	};
+}
@@ -0,0 +1,194 @@
+#include "stdafx.h"
+#include "Pipeline.h"
+
+#include "PostgresUtils.h"
+#include "StatementParameters.h"
+
+namespace systelab::db::postgresql {
+
+	Pipeline::Pipeline(PGconn* connection, BusyConnectionLock lock, unsigned int maxPendingStatements, CommandCallback onCommandCompleted)
+		: m_connection(connection)
+		, m_lock(std::move(lock))
+		, m_maxPendingStatements(std::max(maxPendingStatements, 1U))
+		, m_pendingStatementsCount(0)
+		, m_onCommandCompleted(std::move(onCommandCompleted))
+	{
+		if (PQenterPipelineMode(m_connection) != 1)
+		{
+			throw std::runtime_error(std::string("Unable to enter pipeline mode: ") + PQerrorMessage(m_connection));
+		}
+	}
+
+	Pipeline::~Pipeline()
+	{
+		// A connection left in pipeline mode would fail every later statement, so when it can't be restored
+		// it is flagged for the pool to discard it
+		if (!discardPendingResults())
+		{
+			m_lock.markConnectionBroken();
+		}
+	}
+
+	void Pipeline::addOperation(const std::string& operation)
+	{
+		onOperationSent(PQsendQueryParams(m_connection, operation.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 0));
+	}
+
+	void Pipeline::addOperation(const std::string& operation, const StatementParameters& parameters)
+	{
+		onOperationSent(PQsendQueryParams(m_connection, operation.c_str(), static_cast<int>(parameters.getCount()),
+										  nullptr, parameters.getValues(), parameters.getLengths(), parameters.getFormats(), 0));
+	}
+
+	void Pipeline::addSyncPoint()
+	{
+		if (PQpipelineSync(m_connection) != 1)
+		{
+			throw std::runtime_error(std::string("Unable to send pipeline sync: ") + PQerrorMessage(m_connection));
+		}
+
+		m_pendingItems.push_back(PendingItem::SYNC);
+	}
+
+	std::vector<Pipeline::StatementResult> Pipeline::getResults()
+	{
+		if (!m_pendingItems.empty() && m_pendingItems.back() != PendingItem::SYNC)
+		{
+			addSyncPoint();
+		}
+
+		readPendingResults();
+		return std::exchange(m_results, {});
+	}
+
+	bool Pipeline::discardPendingResults()
+	{
+		if (!m_pendingItems.empty() && m_pendingItems.back() != PendingItem::SYNC)
+		{
+			// Without a sync the server wouldn't send the results of the last operations
+			if (PQpipelineSync(m_connection) != 1)
+			{
+				return false;
+			}
+		}
+
+		m_pendingItems.clear();
+		m_results.clear();
+
+		// Pipeline mode can only be exited once the result of the last sync has been read. A null result
+		// ends the results of each operation, two in a row mean no more results will arrive
+		unsigned int consecutiveNullResultsCount = 0;
+		while (PQexitPipelineMode(m_connection) != 1)
+		{
+			if (PQstatus(m_connection) != CONNECTION_OK)
+			{
+				return false;
+			}
+
+			PGresult* pendingResult = PQgetResult(m_connection);
+			if (pendingResult == nullptr)
+			{
+				if (++consecutiveNullResultsCount > 1)
+				{
+					return false;
+				}
+			}
+			else
+			{
+				// Discarded operations were executed anyway, so their schema changes are still reported
+				consecutiveNullResultsCount = 0;
+				reportCommand(pendingResult);
+				PQclear(pendingResult);
+			}
+		}
+
+		return true;
+	}
+
+	void Pipeline::onOperationSent(int sent)
+	{
+		if (sent != 1)
+		{
+			throw std::runtime_error(std::string("Unable to queue pipeline operation: ") + PQerrorMessage(m_connection));
+		}
+
+		m_pendingItems.push_back(PendingItem::STATEMENT);
+		m_pendingStatementsCount++;
+
+		// Results are read from time to time, so neither side blocks with its send buffer full
+		if (m_pendingStatementsCount >= m_maxPendingStatements)
+		{
+			if (PQsendFlushRequest(m_connection) != 1 || PQflush(m_connection) != 0)
+			{
+				throw std::runtime_error(std::string("Unable to flush pipeline: ") + PQerrorMessage(m_connection));
+			}
+
+			readPendingResults();
+		}
+	}
+
+	void Pipeline::readPendingResults()
+	{
+		while (!m_pendingItems.empty())
+		{
+			const PendingItem item = m_pendingItems.front();
+			m_pendingItems.pop_front();
+
+			if (item == PendingItem::STATEMENT)
+			{
+				m_results.push_back(readStatementResult());
+				m_pendingStatementsCount--;
+			}
+			else
+			{
+				const auto syncResult = utils::createRAIIPGresult(PQgetResult(m_connection));
+				if (PQresultStatus(syncResult.get()) != PGRES_PIPELINE_SYNC)
+				{
+					throw std::runtime_error(std::string("Unexpected pipeline result: ") + PQerrorMessage(m_connection));
+				}
+			}
+		}
+	}
+
+	Pipeline::StatementResult Pipeline::readStatementResult()
+	{
+		StatementResult statementResult;
+		const auto result = utils::createRAIIPGresult(PQgetResult(m_connection));
+		switch (PQresultStatus(result.get()))
+		{
+			case PGRES_COMMAND_OK:
+			case PGRES_TUPLES_OK:
+				statementResult.status = StatementStatus::SUCCEEDED;
+				statementResult.rowsAffected = static_cast<RowsAffected>(std::atoi(PQcmdTuples(result.get())));
+				reportCommand(result.get());
+				break;
+			case PGRES_PIPELINE_ABORTED:
+				statementResult.status = StatementStatus::ABORTED;
+				break;
+			default:
+				statementResult.status = StatementStatus::FAILED;
+				statementResult.errorMessage = PQresultErrorMessage(result.get());
+				break;
+		}
+
+		// Each statement ends with a null result
+		if (result)
+		{
+			while (PGresult* remainingResult = PQgetResult(m_connection))
+			{
+				PQclear(remainingResult);
+			}
+		}
+
+		return statementResult;
+	}
+
+	void Pipeline::reportCommand(const PGresult* result)
+	{
+		const ExecStatusType status = PQresultStatus(result);
+		if (m_onCommandCompleted && (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK))
+		{
+			m_onCommandCompleted(PQcmdStatus(const_cast<PGresult*>(result)));
+		}
+	}
+}
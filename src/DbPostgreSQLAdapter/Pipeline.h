@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DbAdapterInterface/Types.h"
+
+#include "BusyConnectionLock.h"
+
+typedef struct pg_conn PGconn;
+typedef struct pg_result PGresult;
+
+namespace systelab::db::postgresql {
+	class StatementParameters;
+
+	// Queues operations using the libpq pipeline mode, so they are sent without waiting for the
+	// result of the previous one. The connection is kept locked and busy until the pipeline is destroyed,
+	// so the pipeline must be used and destroyed on the thread that created it.
+	class Pipeline
+	{
+	public:
+		// Invoked with the command tag of each succeeded operation, so the owner can react to schema changes
+		typedef std::function<void(std::string_view)> CommandCallback;
+
+		enum class StatementStatus
+		{
+			SUCCEEDED = 0,
+			FAILED = 1,
+			ABORTED = 2
+		};
+
+		struct StatementResult
+		{
+			StatementStatus status = StatementStatus::SUCCEEDED;
+			RowsAffected rowsAffected = 0;
+			std::string errorMessage;
+		};
+
+		Pipeline(PGconn* connection, BusyConnectionLock lock, unsigned int maxPendingStatements, CommandCallback onCommandCompleted);
+		~Pipeline();
+
+		void addOperation(const std::string& operation);
+		void addOperation(const std::string& operation, const StatementParameters& parameters);
+
+		// Operations between sync points run in a single implicit transaction, so a failure rolls them back
+		// and aborts the following ones. Operations queued after a sync point are executed anyway.
+		void addSyncPoint();
+
+		// Results are returned in the order the operations were added
+		std::vector<StatementResult> getResults();
+
+	private:
+		enum class PendingItem
+		{
+			STATEMENT,
+			SYNC
+		};
+
+		PGconn* m_connection;
+		BusyConnectionLock m_lock;
+		unsigned int m_maxPendingStatements;
+		unsigned int m_pendingStatementsCount;
+		std::deque<PendingItem> m_pendingItems;
+		std::vector<StatementResult> m_results;
+		CommandCallback m_onCommandCompleted;
+
+		bool discardPendingResults();
+		void onOperationSent(int sent);
+		void readPendingResults();
+		StatementResult readStatementResult();
+		void reportCommand(const PGresult* result);
+	};
+}
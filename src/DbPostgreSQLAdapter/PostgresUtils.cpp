@@ -43,6 +43,91 @@ namespace systelab::db::postgresql::utils {
 				);
 	}
 
+	std::int64_t parseBigIntValue(std::string_view value)
+	{
+		std::int64_t bigIntValue = 0;
+		const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), bigIntValue);
+		if (error != std::errc() || end != value.data() + value.size())
+		{
+			throw std::runtime_error("Invalid integer value: " + std::string(value));
+		}
+
+		return bigIntValue;
+	}
+
+	int toIntValue(std::int64_t value)
+	{
+		if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+		{
+			throw std::runtime_error("Integer value out of range.");
+		}
+
+		return static_cast<int>(value);
+	}
+
+	void decodeByteaText(std::string_view text, std::string& data)
+	{
+		data.clear();
+		if (text.starts_with("\\x"))
+		{
+			if ((text.size() % 2) != 0)
+			{
+				throw std::runtime_error("Invalid bytea value.");
+			}
+
+			data.reserve((text.size() - 2) / 2);
+			for (std::size_t i = 2; i < text.size(); i += 2)
+			{
+				unsigned char byte = 0;
+				const auto [end, error] = std::from_chars(text.data() + i, text.data() + i + 2, byte, 16);
+				if (error != std::errc() || end != text.data() + i + 2)
+				{
+					throw std::runtime_error("Invalid bytea value.");
+				}
+
+				data.push_back(static_cast<char>(byte));
+			}
+		}
+		else
+		{
+			// Escape format, only sent by servers configured with bytea_output = 'escape'
+			const std::string escapedText(text);
+			std::size_t length = 0;
+			std::unique_ptr<unsigned char, void(*)(void*)> unescapedData(
+				PQunescapeBytea(reinterpret_cast<const unsigned char*>(escapedText.c_str()), &length), PQfreemem);
+			if (!unescapedData)
+			{
+				throw std::runtime_error("Invalid bytea value.");
+			}
+
+			data.assign(reinterpret_cast<const char*>(unescapedData.get()), length);
+		}
+	}
+
+	void appendByteaText(std::string_view data, std::string& text)
+	{
+		const char HEX_DIGITS[] = "0123456789abcdef";
+		text.reserve(text.size() + 2 + data.size() * 2);
+		text += "\\x";
+		for (const char character : data)
+		{
+			const auto byte = static_cast<unsigned char>(character);
+			text.push_back(HEX_DIGITS[byte >> 4]);
+			text.push_back(HEX_DIGITS[byte & 0x0F]);
+		}
+	}
+
+	std::string getStringLiteral(const std::string& value)
+	{
+		std::string literal = "'";
+		for (const char character : value)
+		{
+			literal += (character == '\'') ? "''" : std::string(1, character);
+		}
+
+		return literal + "'";
+	}
+
 	void throwPostgressException(const PGresult* statementResult, const std::source_location& srcLocation)
 	{
 		const std::string errorMessage = PQresultErrorMessage(statementResult);
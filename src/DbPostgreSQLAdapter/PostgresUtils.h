@@ -13,6 +13,13 @@ namespace systelab::db::postgresql::utils {
 	bool isDateTimeNull(const std::chrono::system_clock::time_point& dateTime);
 
 	bool isBooleanTrue(const std::string& postgresBoolean);
+	std::int64_t parseBigIntValue(std::string_view value);
+	int toIntValue(std::int64_t value);
+	std::string getStringLiteral(const std::string& value);
+
+	// Text representation of bytea values, decoding both the hex and the escape output formats
+	void decodeByteaText(std::string_view text, std::string& data);
+	void appendByteaText(std::string_view data, std::string& text);
 
 	void throwPostgressException(const PGresult* statementResult, const std::source_location& srcLocation = std::source_location::current());
 }
\ No newline at end of file
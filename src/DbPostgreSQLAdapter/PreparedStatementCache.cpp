@@ -0,0 +1,107 @@
+#include "stdafx.h"
+#include "PreparedStatementCache.h"
+
+#include "PostgresUtils.h"
+
+namespace systelab::db::postgresql {
+
+	PreparedStatementCache::PreparedStatementCache(PGconn* connection, unsigned int capacity)
+		: m_connection(connection)
+		, m_capacity(std::max(capacity, 1U))
+	{
+	}
+
+	const std::string& PreparedStatementCache::getStatementName(const std::string& statementKey,
+																const std::function<std::string()>& statementBuilder,
+																unsigned int parametersCount)
+	{
+		auto statementIterator = m_statements.find(statementKey);
+		if (statementIterator != m_statements.end())
+		{
+			m_statistics.hits++;
+			m_usageOrder.splice(m_usageOrder.begin(), m_usageOrder, statementIterator->second.usageIterator);
+			return statementIterator->second.name;
+		}
+
+		m_statistics.misses++;
+		const std::string statementName = "systelab_stmt_" + std::to_string(m_nextStatementId++);
+		const std::string statement = statementBuilder();
+		const auto prepareResult = utils::createRAIIPGresult(PQprepare(m_connection, statementName.c_str(), statement.c_str(),
+																	   static_cast<int>(parametersCount), nullptr));
+		if (PQresultStatus(prepareResult.get()) != PGRES_COMMAND_OK)
+		{
+			utils::throwPostgressException(prepareResult.get());
+		}
+
+		m_usageOrder.push_front(statementKey);
+		statementIterator = m_statements.emplace(statementKey, CachedStatement{ statementName, m_usageOrder.begin() }).first;
+		while (m_statements.size() > m_capacity)
+		{
+			evictLeastRecentlyUsed();
+		}
+
+		return statementIterator->second.name;
+	}
+
+	void PreparedStatementCache::setCapacity(unsigned int capacity)
+	{
+		m_capacity = std::max(capacity, 1U);
+		while (m_statements.size() > m_capacity)
+		{
+			evictLeastRecentlyUsed();
+		}
+	}
+
+	void PreparedStatementCache::remove(const std::string& statementKey)
+	{
+		const auto statementIterator = m_statements.find(statementKey);
+		if (statementIterator != m_statements.end())
+		{
+			deallocate(statementIterator);
+		}
+	}
+
+	void PreparedStatementCache::clear()
+	{
+		if (m_statements.empty())
+		{
+			return;
+		}
+
+		// Statement names aren't reused, so a failed DEALLOCATE only leaks the statements until the session ends
+		std::string deallocate;
+		for (const auto& [statementKey, cachedStatement] : m_statements)
+		{
+			deallocate.append("DEALLOCATE ").append(cachedStatement.name).append(";");
+		}
+		utils::createRAIIPGresult(PQexec(m_connection, deallocate.c_str()));
+
+		m_statistics.evictions += m_statements.size();
+		m_statements.clear();
+		m_usageOrder.clear();
+	}
+
+	PreparedStatementCache::Statistics PreparedStatementCache::getStatistics() const
+	{
+		Statistics statistics = m_statistics;
+		statistics.size = static_cast<unsigned int>(m_statements.size());
+		statistics.capacity = m_capacity;
+		return statistics;
+	}
+
+	void PreparedStatementCache::evictLeastRecentlyUsed()
+	{
+		deallocate(m_statements.find(m_usageOrder.back()));
+	}
+
+	void PreparedStatementCache::deallocate(std::unordered_map<std::string, CachedStatement>::iterator statementIterator)
+	{
+		// A failed DEALLOCATE (i.e. inside an aborted transaction) only leaks the statement until the session ends
+		const std::string deallocate = "DEALLOCATE " + statementIterator->second.name;
+		utils::createRAIIPGresult(PQexec(m_connection, deallocate.c_str()));
+
+		m_usageOrder.erase(statementIterator->second.usageIterator);
+		m_statements.erase(statementIterator);
+		m_statistics.evictions++;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db::postgresql {
+
+	class PreparedStatementCache
+	{
+	public:
+		struct Statistics
+		{
+			unsigned long long hits = 0;
+			unsigned long long misses = 0;
+			unsigned long long evictions = 0;
+			unsigned int size = 0;
+			unsigned int capacity = 0;
+		};
+
+		PreparedStatementCache(PGconn* connection, unsigned int capacity);
+		~PreparedStatementCache() = default;
+
+		const std::string& getStatementName(const std::string& statementKey,
+											const std::function<std::string()>& statementBuilder,
+											unsigned int parametersCount);
+
+		void setCapacity(unsigned int capacity);
+		// Deallocates a single statement, i.e. when its cached plan no longer matches its tables
+		void remove(const std::string& statementKey);
+		// Deallocates all the cached statements, as their plans may no longer match the tables after DDL
+		void clear();
+		Statistics getStatistics() const;
+
+	private:
+		struct CachedStatement
+		{
+			std::string name;
+			std::list<std::string>::iterator usageIterator;
+		};
+
+		PGconn* m_connection;
+		unsigned int m_capacity;
+		unsigned long long m_nextStatementId = 0;
+		std::unordered_map<std::string, CachedStatement> m_statements;
+		std::list<std::string> m_usageOrder;
+		Statistics m_statistics;
+
+		void evictLeastRecentlyUsed();
+		void deallocate(std::unordered_map<std::string, CachedStatement>::iterator statementIterator);
+	};
+}
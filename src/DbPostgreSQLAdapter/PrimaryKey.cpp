@@ -18,6 +18,8 @@ namespace systelab { namespace db { namespace postgresql {
 				m_fields.push_back(&tableField);
 			}
 		}
+
+		m_fieldNameIndex = FieldNameIndex::create(m_fields);
 	}
 
 	ITable& PrimaryKey::getTable() const
@@ -37,17 +39,17 @@ namespace systelab { namespace db { namespace postgresql {
 
 	const IField& PrimaryKey::getField(const std::string& fieldName) const
 	{
-		const auto fieldIterator = std::ranges::find_if(m_fields, 
-			[&fieldName](const IField* field)
-			{ 
-				return field->getName() == fieldName; 
-			});
-		
-		if (fieldIterator != m_fields.end())
+		const auto fieldIndex = m_fieldNameIndex->find(fieldName);
+		if (fieldIndex)
 		{
-			return **fieldIterator;
+			return *m_fields[*fieldIndex];
 		}
 
 		throw std::runtime_error( "The requested primary key field doesn't exist" );
 	}
+
+	std::shared_ptr<const FieldNameIndex> PrimaryKey::getFieldNameIndex() const
+	{
+		return m_fieldNameIndex;
+	}
 }}}
\ No newline at end of file
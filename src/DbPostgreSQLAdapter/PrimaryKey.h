@@ -2,6 +2,8 @@
 
 #include "DbAdapterInterface/IPrimaryKey.h"
 
+#include "FieldNameIndex.h"
+
 namespace systelab {
 	namespace db {
 		class IField;
@@ -23,8 +25,11 @@ namespace systelab { namespace db { namespace postgresql {
 		const IField& getField(unsigned int index) const override;
 		const IField& getField(const std::string& fieldName) const override;
 
+		std::shared_ptr<const FieldNameIndex> getFieldNameIndex() const;
+
 	private:
 		ITable& m_table;
 		std::vector<const IField*> m_fields;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
 	};
 }}}
\ No newline at end of file
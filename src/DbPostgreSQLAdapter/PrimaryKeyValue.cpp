@@ -7,8 +7,9 @@
 
 namespace systelab::db::postgresql {
 
-	PrimaryKeyValue::PrimaryKeyValue(const IPrimaryKey& primaryKey)
+	PrimaryKeyValue::PrimaryKeyValue(const PrimaryKey& primaryKey)
 		:m_primaryKey(primaryKey)
+		,m_fieldNameIndex(primaryKey.getFieldNameIndex())
 	{
 		const unsigned int nPrimaryKeyFields = m_primaryKey.getFieldsCount();
 		for (unsigned int i = 0; i < nPrimaryKeyFields; i++)
@@ -80,15 +81,10 @@ namespace systelab::db::postgresql {
 
 	IFieldValue& PrimaryKeyValue::getFieldValue(const std::string& fieldName) const
 	{
-		const auto fieldValue = std::ranges::find_if(m_fieldValues, 
-			[&fieldName] (const std::unique_ptr<IFieldValue>& field) 
-			{ 
-				return field->getField().getName() == fieldName;
-			});
-
-		if (fieldValue != m_fieldValues.cend())
+		const auto fieldValueIndex = m_fieldNameIndex->find(fieldName);
+		if (fieldValueIndex)
 		{
-			return *(fieldValue->get());
+			return *m_fieldValues[*fieldValueIndex];
 		}
 
 		throw std::runtime_error( "The requested primary key field doesn't exist" );
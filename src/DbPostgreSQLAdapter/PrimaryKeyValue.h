@@ -3,11 +3,13 @@
 #include "DbAdapterInterface/IPrimaryKeyValue.h"
 
 namespace systelab { namespace db { namespace postgresql {
+	class FieldNameIndex;
+	class PrimaryKey;
 
 	class PrimaryKeyValue : public IPrimaryKeyValue
 	{
 	public:
-		PrimaryKeyValue(const IPrimaryKey& primaryKey);
+		PrimaryKeyValue(const PrimaryKey& primaryKey);
 		~PrimaryKeyValue() override = default;
 
 		ITable& getTable() const override;
@@ -20,5 +22,6 @@ namespace systelab { namespace db { namespace postgresql {
 	private:
 		const IPrimaryKey& m_primaryKey;
 		std::vector<std::unique_ptr<IFieldValue>> m_fieldValues;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
 	};
 }}}
\ No newline at end of file
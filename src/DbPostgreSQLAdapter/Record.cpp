@@ -5,55 +5,27 @@
 #include "DbAdapterInterface/Types.h"
 #include "Field.h"
 #include "FieldValue.h"
-#include "PostgresUtils.h"
+#include "ResultDecoder.h"
 
 namespace systelab::db::postgresql {
 
-	Record::Record(IRecordSet& recordSet, const PGresult* statementResult, const int rowIndex)
+	Record::Record(IRecordSet& recordSet, const PGresult* statementResult, const int rowIndex,
+				   std::shared_ptr<const FieldNameIndex> fieldNameIndex, std::pmr::memory_resource* arena)
+		: m_fieldValues(arena != nullptr ? arena : std::pmr::get_default_resource())
+		, m_fieldNameIndex(std::move(fieldNameIndex))
 	{
 		const unsigned int fieldsCount = recordSet.getFieldsCount();
+		m_fieldValues.reserve(fieldsCount);
 		for (unsigned int i = 0; i < fieldsCount; i++)
 		{
-			std::unique_ptr<IFieldValue> fieldValue;
 			const IField& field = recordSet.getField(i);
 			const unsigned int fieldIndex = field.getIndex();
-			if (PQgetisnull(statementResult, rowIndex, fieldIndex) == 1)
-			{
-				fieldValue = std::make_unique<FieldValue>(field);
-			}
-			else
-			{
-				const FieldTypes fieldType = field.getType();
-				const std::string value = PQgetvalue(statementResult, rowIndex, fieldIndex);
-				switch(fieldType)
-				{
-					case BOOLEAN:
-						fieldValue = std::make_unique<FieldValue>(field, utils::isBooleanTrue(value));
-						break;
-					case INT:
-						fieldValue = std::make_unique<FieldValue>(field, std::stoi(value));
-						break;
-					case DOUBLE:
-						fieldValue = std::make_unique<FieldValue>(field, std::stod(value));
-						break;
-					case STRING:
-						fieldValue = std::make_unique<FieldValue>(field, std::string(value));
-						break;
-
-					case DATETIME:
-						fieldValue = std::make_unique<FieldValue>(field, utils::stringISOToDateTime(value));
-						break;
-					case BINARY:
-					default:
-						throw std::runtime_error( "Unknown field type." );
-				}
-			}
-
-			m_fieldValues.push_back(std::move(fieldValue));
+			m_fieldValues.push_back(utils::decodeFieldValue(field, statementResult, rowIndex, fieldIndex, arena));
 		}
 	}
 
-	Record::Record(std::vector<std::unique_ptr<IFieldValue>>& fieldValues)
+	Record::Record(std::vector<std::unique_ptr<IFieldValue>>& fieldValues, std::shared_ptr<const FieldNameIndex> fieldNameIndex)
+		: m_fieldNameIndex(std::move(fieldNameIndex))
 	{
 		const unsigned int nFieldValues = static_cast<unsigned int>(fieldValues.size());
 		for (unsigned int i = 0; i < nFieldValues; i++)
@@ -74,29 +46,40 @@ namespace systelab::db::postgresql {
 
 	IFieldValue& Record::getFieldValue(const std::string& fieldName) const
 	{
-		const auto fieldValueIterator = std::ranges::find_if(m_fieldValues,
-			[&fieldName](const std::unique_ptr<IFieldValue>& fieldValue)
-			{
-				return fieldValue->getField().getName() == fieldName;
-			});
-
-		if (fieldValueIterator != m_fieldValues.cend())
+		const auto fieldValueIndex = findFieldValueIndex(fieldName);
+		if (fieldValueIndex)
 		{
-			return **fieldValueIterator;
+			return *m_fieldValues[*fieldValueIndex];
 		}
 
-
 		throw std::runtime_error( "The requested field value doesn't exist" );
 	}
 
 	bool Record::hasFieldValue(const std::string& fieldName) const
 	{
-		const auto fieldValueIterator = std::ranges::find_if(m_fieldValues,
-			[&fieldName](const std::unique_ptr<IFieldValue>& fieldValue)
+		return findFieldValueIndex(fieldName).has_value();
+	}
+
+	std::optional<unsigned int> Record::findFieldValueIndex(const std::string& fieldName) const
+	{
+		if (m_fieldNameIndex)
+		{
+			const auto fieldIndex = m_fieldNameIndex->find(fieldName);
+			if (fieldIndex && *fieldIndex < m_fieldValues.size() && m_fieldValues[*fieldIndex]->getField().getIndex() == *fieldIndex)
+			{
+				return fieldIndex;
+			}
+		}
+
+		const unsigned int fieldValuesCount = static_cast<unsigned int>(m_fieldValues.size());
+		for (unsigned int i = 0; i < fieldValuesCount; i++)
+		{
+			if (m_fieldValues[i]->getField().getName() == fieldName)
 			{
-				return fieldValue->getField().getName() == fieldName;
-			});
+				return i;
+			}
+		}
 
-		return fieldValueIterator != m_fieldValues.cend();
+		return std::nullopt;
 	}
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "DbAdapterInterface/IRecord.h"
 
+#include "FieldNameIndex.h"
+#include "RecordArena.h"
+
 namespace systelab::db {
 	class IFieldValue;
 	class IRecordSet;
@@ -12,8 +15,9 @@ namespace systelab::db::postgresql {
 	class Record : public IRecord
 	{
 	public:
-		Record(IRecordSet& recordSet, const PGresult* statementResult, const int rowIndex);
-		Record(std::vector<std::unique_ptr<IFieldValue>>&);
+		Record(IRecordSet& recordSet, const PGresult* statementResult, const int rowIndex,
+			   std::shared_ptr<const FieldNameIndex> fieldNameIndex, std::pmr::memory_resource* arena = nullptr);
+		Record(std::vector<std::unique_ptr<IFieldValue>>&, std::shared_ptr<const FieldNameIndex> fieldNameIndex = nullptr);
 		~Record() override = default;
 
 		unsigned int getFieldValuesCount() const override;
@@ -23,6 +27,9 @@ namespace systelab::db::postgresql {
 		bool hasFieldValue(const std::string& fieldName) const override;
 
 	private:
-		std::vector<std::unique_ptr<IFieldValue>> m_fieldValues;
+		std::pmr::vector<ArenaPtr<IFieldValue>> m_fieldValues;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+
+		std::optional<unsigned int> findFieldValueIndex(const std::string& fieldName) const;
 	};
 }
\ No newline at end of file
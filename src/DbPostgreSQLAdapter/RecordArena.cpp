@@ -0,0 +1,15 @@
+#include "stdafx.h"
+#include "RecordArena.h"
+
+#include "FieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	std::size_t getRecordArenaInitialSize(const PGresult* statementResult, std::size_t recordSize)
+	{
+		const std::size_t rowsCount = static_cast<std::size_t>(PQntuples(statementResult));
+		const std::size_t fieldsCount = static_cast<std::size_t>(PQnfields(statementResult));
+		const std::size_t fieldValueSize = sizeof(FieldValue) + sizeof(ArenaPtr<IFieldValue>);
+		return std::max<std::size_t>(rowsCount * (recordSize + fieldsCount * fieldValueSize), 1);
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db::postgresql {
+
+	// Objects placed in a record set arena are only destroyed, their memory is released with the arena
+	template<typename T>
+	struct ArenaDeleter
+	{
+		bool arenaAllocated = false;
+
+		ArenaDeleter() = default;
+		ArenaDeleter(bool arenaAllocated)
+			: arenaAllocated(arenaAllocated)
+		{}
+
+		template<typename U>
+		ArenaDeleter(const ArenaDeleter<U>& other)
+			: arenaAllocated(other.arenaAllocated)
+		{}
+
+		template<typename U>
+		ArenaDeleter(const std::default_delete<U>&)
+		{}
+
+		void operator()(T* object) const
+		{
+			if (arenaAllocated)
+			{
+				std::destroy_at(object);
+			}
+			else
+			{
+				delete object;
+			}
+		}
+	};
+
+	template<typename T>
+	using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+	// Heap allocates the object when no arena is given
+	template<typename T, typename... Args>
+	ArenaPtr<T> makeArenaObject(std::pmr::memory_resource* arena, Args&&... args)
+	{
+		if (arena == nullptr)
+		{
+			return ArenaPtr<T>(new T(std::forward<Args>(args)...));
+		}
+
+		void* storage = arena->allocate(sizeof(T), alignof(T));
+		return ArenaPtr<T>(new (storage) T(std::forward<Args>(args)...), ArenaDeleter<T>(true));
+	}
+
+	std::size_t getRecordArenaInitialSize(const PGresult* statementResult, std::size_t recordSize);
+}
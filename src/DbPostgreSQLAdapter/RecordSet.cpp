@@ -1,57 +1,40 @@
 #include "stdafx.h"
 #include "RecordSet.h"
 
-#include "DefaultOID.h"
-#include "Field.h"
+#include "LazyRecord.h"
 #include "Record.h"
+#include "ResultFields.h"
+#include "ResultFieldsCache.h"
 
 #include "DbAdapterInterface/IFieldValue.h"
 
 namespace systelab::db::postgresql {
 
-	namespace {
-		FieldTypes translateFromOIDtoFieldType(const PostgresqlOID oid)
+	RecordSet::RecordSet(const PGresult* statementResult)
+		: m_arena(getRecordArenaInitialSize(statementResult, sizeof(Record)))
+	{
+		m_resultFields = ResultFieldsCache::getInstance().getResultFields(statementResult);
+		m_fieldNameIndex = m_resultFields->getFieldNameIndex();
+
+		const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult));
+		m_records.reserve(rowsCount);
+		for (unsigned int i = 0; i < rowsCount; i++)
 		{
-			switch (oid)
-			{
-				case(PostgresqlOID::boolOID):
-					return FieldTypes::BOOLEAN;
-					break;
-				case(PostgresqlOID::bytearrayOID):
-					return FieldTypes::BINARY;
-					break;
-				case(PostgresqlOID::smallIntIOD):
-				case(PostgresqlOID::intOID):
-					return FieldTypes::INT;
-					break;
-				case(PostgresqlOID::pidOID):
-				case(PostgresqlOID::nameOID):
-				case(PostgresqlOID::charOID):
-				case(PostgresqlOID::textOID):
-				case(PostgresqlOID::varcharOID):
-					return FieldTypes::STRING;
-					break;
-				case(PostgresqlOID::floatOID):
-				case(PostgresqlOID::doubleOID):
-					return FieldTypes::DOUBLE;
-					break;
-				case(PostgresqlOID::datetimeOID):
-					return FieldTypes::DATETIME;
-					break;
-			}
-
-			throw ("OID type not defined");
+			m_records.push_back(makeArenaObject<Record>(&m_arena, *this, statementResult, i, m_fieldNameIndex, &m_arena));
 		}
+
+		m_iterator = m_records.begin();
 	}
 
-	RecordSet::RecordSet(const PGresult* statementResult)
+	RecordSet::RecordSet(std::shared_ptr<const PGresult> statementResult)
 	{
-		createFields(statementResult);
+		m_resultFields = ResultFieldsCache::getInstance().getResultFields(statementResult.get());
+		m_fieldNameIndex = m_resultFields->getFieldNameIndex();
 
-		const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult));
+		const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult.get()));
 		for (unsigned int i = 0; i < rowsCount; i++)
 		{
-			m_records.push_back(std::make_unique<Record>(*this, statementResult, i));
+			m_records.push_back(std::make_unique<LazyRecord>(*this, statementResult, i, m_fieldNameIndex.get()));
 		}
 
 		m_iterator = m_records.begin();
@@ -64,26 +47,17 @@ namespace systelab::db::postgresql {
 
 	unsigned int RecordSet::getFieldsCount() const
 	{
-		return (unsigned int) m_fields.size();
+		return m_resultFields->getFieldsCount();
 	}
 
 	const IField& RecordSet::getField(unsigned int index) const
 	{
-		return *m_fields.at(index);
+		return m_resultFields->getField(index);
 	}
 
 	const IField& RecordSet::getField(const std::string& fieldName) const
 	{
-		unsigned int nFields = (unsigned int) m_fields.size();
-		for (unsigned int i = 0; i < nFields; i++)
-		{
-			if (m_fields.at(i)->getName() == fieldName)
-			{
-				return *m_fields.at(i);
-			}
-		}
-
-		throw std::runtime_error( "The requested field doesn't exist" );
+		return m_resultFields->getField(fieldName);
 	}
 
 	unsigned int RecordSet::getRecordsCount() const
@@ -108,7 +82,7 @@ namespace systelab::db::postgresql {
 			copiedFieldValues.push_back( fieldValue.clone() );
 		}
 
-		return std::make_unique<Record>(copiedFieldValues);
+		return std::make_unique<Record>(copiedFieldValues, m_fieldNameIndex);
 	}
 
 	bool RecordSet::isCurrentRecordValid() const
@@ -120,18 +94,4 @@ namespace systelab::db::postgresql {
 	{
 		m_iterator++;
 	}
-
-	void RecordSet::createFields(const PGresult* statementResult)
-	{
-		int fieldsCount = PQnfields(statementResult);
-		for (int i = 0; i < fieldsCount; i++)
-		{
-			std::string fieldName(PQfname(statementResult, i));
-			int postgresqlFieldType = PQftype(statementResult, i);
-
-			FieldTypes fieldType = translateFromOIDtoFieldType(static_cast<PostgresqlOID>(postgresqlFieldType));
-			std::unique_ptr<IField> field(new Field(i, fieldName, fieldType, "", false));
-			m_fields.push_back(std::move(field));
-		}
-	}
 }
\ No newline at end of file
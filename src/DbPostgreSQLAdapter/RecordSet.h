@@ -2,6 +2,9 @@
 
 #include "DbAdapterInterface/IRecordSet.h"
 
+#include "FieldNameIndex.h"
+#include "RecordArena.h"
+
 typedef struct pg_result PGresult;
 
 namespace systelab::db {
@@ -11,10 +14,14 @@ namespace systelab::db {
 
 namespace systelab::db::postgresql {
 
+	class ResultFields;
+
 	class RecordSet : public IRecordSet
 	{
 	public:
 		RecordSet(const PGresult* statementResult);
+		// Records keep the result alive and decode each value on first access
+		RecordSet(std::shared_ptr<const PGresult> statementResult);
 		~RecordSet() override;
 
 		unsigned int getFieldsCount() const override;
@@ -29,10 +36,10 @@ namespace systelab::db::postgresql {
 		void nextRecord() override;
 
 	private:
-		std::vector<std::unique_ptr<IField>> m_fields;
-		std::vector<std::unique_ptr<IRecord>> m_records;
-		std::vector<std::unique_ptr<IRecord>>::iterator m_iterator;
-
-		void createFields(const PGresult* statementResult);
+		std::pmr::monotonic_buffer_resource m_arena;
+		std::shared_ptr<const ResultFields> m_resultFields;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::vector<ArenaPtr<IRecord>> m_records;
+		std::vector<ArenaPtr<IRecord>>::iterator m_iterator;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+	enum class RecordSetMode {
+		MATERIALIZED = 0,
+		STREAMING = 1,
+		LAZY = 2
+	};
+}
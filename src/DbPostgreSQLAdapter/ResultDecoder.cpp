@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "ResultDecoder.h"
+
+#include "BinaryValue.h"
+#include "DefaultOID.h"
+#include "Field.h"
+#include "FieldValue.h"
+#include "PostgresUtils.h"
+#include "TypeRegistry.h"
+
+namespace systelab::db::postgresql::utils {
+
+	namespace {
+		bool isBinaryValue(const PGresult* statementResult, int columnIndex)
+		{
+			return PQfformat(statementResult, columnIndex) != 0;
+		}
+
+		[[noreturn]] void throwUnsupportedBinaryFormat(const PostgresqlOID oid)
+		{
+			throw std::runtime_error("Binary format not supported for type OID " + std::to_string(static_cast<int>(oid)));
+		}
+
+		template<typename T>
+		T decodeValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+		{
+			// Decoders that rebuild a string leave it here, until the next value is decoded on the thread
+			thread_local std::string decodedString;
+
+			const auto oid = static_cast<PostgresqlOID>(PQftype(statementResult, columnIndex));
+			const TypeHandler& handler = TypeRegistry::getInstance().getHandler(oid);
+			const bool binaryValue = isBinaryValue(statementResult, columnIndex);
+			const ValueDecoder decoder = binaryValue ? handler.binaryDecoder : handler.textDecoder;
+			if (decoder == nullptr)
+			{
+				if (binaryValue)
+				{
+					throwUnsupportedBinaryFormat(oid);
+				}
+
+				throw std::runtime_error("Text format not supported for type OID " + std::to_string(static_cast<int>(oid)));
+			}
+
+			const std::string_view data(PQgetvalue(statementResult, rowIndex, columnIndex),
+										static_cast<std::size_t>(PQgetlength(statementResult, rowIndex, columnIndex)));
+			const DecodedValue value = decoder(data, decodedString);
+			const T* typedValue = std::get_if<T>(&value);
+			if (typedValue == nullptr)
+			{
+				throw std::runtime_error("Decoded value doesn't match the field type of type OID " + std::to_string(static_cast<int>(oid)));
+			}
+
+			return *typedValue;
+		}
+	}
+
+	std::vector<std::unique_ptr<IField>> createResultFields(const PGresult* statementResult)
+	{
+		std::vector<std::unique_ptr<IField>> fields;
+		const int fieldsCount = PQnfields(statementResult);
+		for (int i = 0; i < fieldsCount; i++)
+		{
+			std::string fieldName(PQfname(statementResult, i));
+			const auto typeOID = static_cast<PostgresqlOID>(PQftype(statementResult, i));
+			fields.push_back(std::make_unique<Field>(i, fieldName, TypeRegistry::getInstance().getHandler(typeOID).fieldType, "", false, typeOID));
+		}
+
+		return fields;
+	}
+
+	std::unique_ptr<IFieldValue> decodeFieldValue(const IField& field, const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return std::unique_ptr<IFieldValue>(decodeFieldValue(field, statementResult, rowIndex, columnIndex, nullptr).release());
+	}
+
+	ArenaPtr<IFieldValue> decodeFieldValue(const IField& field, const PGresult* statementResult, int rowIndex, int columnIndex,
+										   std::pmr::memory_resource* arena)
+	{
+		if (PQgetisnull(statementResult, rowIndex, columnIndex) == 1)
+		{
+			return makeArenaObject<FieldValue>(arena, field);
+		}
+
+		switch (field.getType())
+		{
+			case BOOLEAN:
+				return makeArenaObject<FieldValue>(arena, field, decodeBooleanValue(statementResult, rowIndex, columnIndex));
+			case INT:
+				return makeArenaObject<FieldValue>(arena, field, decodeBigIntValue(statementResult, rowIndex, columnIndex));
+			case DOUBLE:
+				return makeArenaObject<FieldValue>(arena, field, decodeDoubleValue(statementResult, rowIndex, columnIndex));
+			case STRING:
+				return makeArenaObject<FieldValue>(arena, field, std::string(decodeStringValue(statementResult, rowIndex, columnIndex)));
+			case DATETIME:
+				return makeArenaObject<FieldValue>(arena, field, decodeDateTimeValue(statementResult, rowIndex, columnIndex));
+			case BINARY:
+				return makeArenaObject<FieldValue>(arena, field,
+					std::make_unique<BinaryValue>(decodeBinaryData(statementResult, rowIndex, columnIndex)));
+			default:
+				break;
+		}
+
+		throw std::runtime_error("Unknown field type.");
+	}
+
+	bool decodeBooleanValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<bool>(statementResult, rowIndex, columnIndex);
+	}
+
+	int decodeIntValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return toIntValue(decodeBigIntValue(statementResult, rowIndex, columnIndex));
+	}
+
+	std::int64_t decodeBigIntValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<std::int64_t>(statementResult, rowIndex, columnIndex);
+	}
+
+	double decodeDoubleValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<double>(statementResult, rowIndex, columnIndex);
+	}
+
+	std::string_view decodeStringValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<std::string_view>(statementResult, rowIndex, columnIndex);
+	}
+
+	std::chrono::system_clock::time_point decodeDateTimeValue(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<std::chrono::system_clock::time_point>(statementResult, rowIndex, columnIndex);
+	}
+
+	std::string_view decodeBinaryData(const PGresult* statementResult, int rowIndex, int columnIndex)
+	{
+		return decodeValue<std::string_view>(statementResult, rowIndex, columnIndex);
+	}
+}
\ No newline at end of file
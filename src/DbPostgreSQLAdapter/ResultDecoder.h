@@ -0,0 +1,29 @@
+#pragma once
+
+#include "RecordArena.h"
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db {
+	class IField;
+	class IFieldValue;
+}
+
+namespace systelab::db::postgresql::utils {
+
+	std::vector<std::unique_ptr<IField>> createResultFields(const PGresult* statementResult);
+	std::unique_ptr<IFieldValue> decodeFieldValue(const IField& field, const PGresult* statementResult, int rowIndex, int columnIndex);
+	ArenaPtr<IFieldValue> decodeFieldValue(const IField& field, const PGresult* statementResult, int rowIndex, int columnIndex,
+										   std::pmr::memory_resource* arena);
+
+	// Decode a non-null value of the given cell, either in text or binary format, with the codecs of the
+	// type registry. Decoded strings may only be valid until the next value is decoded on the same thread
+	bool decodeBooleanValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	int decodeIntValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	std::int64_t decodeBigIntValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	double decodeDoubleValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	std::string_view decodeStringValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	std::chrono::system_clock::time_point decodeDateTimeValue(const PGresult* statementResult, int rowIndex, int columnIndex);
+	// In binary format the view points into the result, with no intermediate decoding
+	std::string_view decodeBinaryData(const PGresult* statementResult, int rowIndex, int columnIndex);
+}
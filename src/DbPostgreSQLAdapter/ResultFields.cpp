@@ -0,0 +1,47 @@
+#include "stdafx.h"
+#include "ResultFields.h"
+
+#include "ResultDecoder.h"
+
+#include "DbAdapterInterface/IField.h"
+
+namespace systelab::db::postgresql {
+
+	ResultFields::ResultFields(const PGresult* statementResult)
+		: m_fields(utils::createResultFields(statementResult))
+	{
+		unsigned int position = 0;
+		for (const auto& field : m_fields)
+		{
+			m_fieldNameIndex.add(field->getName(), position++);
+		}
+	}
+
+	ResultFields::~ResultFields() = default;
+
+	unsigned int ResultFields::getFieldsCount() const
+	{
+		return static_cast<unsigned int>(m_fields.size());
+	}
+
+	const IField& ResultFields::getField(unsigned int index) const
+	{
+		return *m_fields.at(index);
+	}
+
+	const IField& ResultFields::getField(const std::string& fieldName) const
+	{
+		const auto fieldIndex = m_fieldNameIndex.find(fieldName);
+		if (fieldIndex)
+		{
+			return *m_fields[*fieldIndex];
+		}
+
+		throw std::runtime_error("The requested field doesn't exist");
+	}
+
+	std::shared_ptr<const FieldNameIndex> ResultFields::getFieldNameIndex() const
+	{
+		return std::shared_ptr<const FieldNameIndex>(shared_from_this(), &m_fieldNameIndex);
+	}
+}
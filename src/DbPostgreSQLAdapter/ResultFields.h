@@ -0,0 +1,32 @@
+#pragma once
+
+#include "FieldNameIndex.h"
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db {
+	class IField;
+}
+
+namespace systelab::db::postgresql {
+
+	// Fields of a query result and their name index. Immutable once built, so they are shared by every
+	// record set whose result has the same column names and types
+	class ResultFields : public std::enable_shared_from_this<ResultFields>
+	{
+	public:
+		ResultFields(const PGresult* statementResult);
+		~ResultFields();
+
+		unsigned int getFieldsCount() const;
+		const IField& getField(unsigned int index) const;
+		const IField& getField(const std::string& fieldName) const;
+
+		// Shares ownership of the fields, so records copied out of a record set can outlive it
+		std::shared_ptr<const FieldNameIndex> getFieldNameIndex() const;
+
+	private:
+		std::vector<std::unique_ptr<IField>> m_fields;
+		FieldNameIndex m_fieldNameIndex;
+	};
+}
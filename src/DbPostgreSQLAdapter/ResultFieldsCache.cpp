@@ -0,0 +1,80 @@
+#include "stdafx.h"
+#include "ResultFieldsCache.h"
+
+#include "ResultFields.h"
+
+namespace systelab::db::postgresql {
+
+	ResultFieldsCache& ResultFieldsCache::getInstance()
+	{
+		static ResultFieldsCache instance;
+		return instance;
+	}
+
+	std::shared_ptr<const ResultFields> ResultFieldsCache::getResultFields(const PGresult* statementResult)
+	{
+		thread_local std::string signature;
+		buildSignature(statementResult, signature);
+
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			const auto resultFieldsIterator = m_resultFields.find(std::string_view(signature));
+			if (resultFieldsIterator != m_resultFields.cend())
+			{
+				m_hits++;
+				return resultFieldsIterator->second;
+			}
+		}
+
+		m_misses++;
+		auto resultFields = std::make_shared<const ResultFields>(statementResult);
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		// Signatures of ad-hoc queries are unbounded, so the cache starts over instead of growing without limit
+		if (m_resultFields.size() >= DEFAULT_CAPACITY)
+		{
+			m_resultFields.clear();
+		}
+
+		return m_resultFields.try_emplace(signature, std::move(resultFields)).first->second;
+	}
+
+	void ResultFieldsCache::clear()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		m_resultFields.clear();
+	}
+
+	ResultFieldsCache::Statistics ResultFieldsCache::getStatistics() const
+	{
+		Statistics statistics;
+		statistics.hits = m_hits;
+		statistics.misses = m_misses;
+		statistics.capacity = DEFAULT_CAPACITY;
+
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		statistics.size = static_cast<unsigned int>(m_resultFields.size());
+		return statistics;
+	}
+
+	std::size_t ResultFieldsCache::SignatureHash::operator()(std::string_view signature) const
+	{
+		return std::hash<std::string_view>{}(signature);
+	}
+
+	void ResultFieldsCache::buildSignature(const PGresult* statementResult, std::string& signature)
+	{
+		signature.clear();
+		std::array<char, 16> oidBuffer;
+		const int fieldsCount = PQnfields(statementResult);
+		for (int i = 0; i < fieldsCount; i++)
+		{
+			const auto result = std::to_chars(oidBuffer.data(), oidBuffer.data() + oidBuffer.size(), PQftype(statementResult, i));
+			signature.append(oidBuffer.data(), result.ptr);
+			signature.push_back(':');
+			signature.append(PQfname(statementResult, i));
+			// Column names can't contain a null character, so it separates them unambiguously
+			signature.push_back('\0');
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+typedef struct pg_result PGresult;
+
+namespace systelab::db::postgresql {
+
+	class ResultFields;
+
+	// Process wide cache of result fields keyed by the type OIDs and names of the result columns
+	class ResultFieldsCache
+	{
+	public:
+		struct Statistics
+		{
+			unsigned long long hits = 0;
+			unsigned long long misses = 0;
+			unsigned int size = 0;
+			unsigned int capacity = 0;
+		};
+
+		static constexpr unsigned int DEFAULT_CAPACITY = 1024;
+
+		static ResultFieldsCache& getInstance();
+
+		std::shared_ptr<const ResultFields> getResultFields(const PGresult* statementResult);
+
+		void clear();
+		Statistics getStatistics() const;
+
+	private:
+		struct SignatureHash
+		{
+			using is_transparent = void;
+			std::size_t operator()(std::string_view signature) const;
+		};
+
+		mutable std::shared_mutex m_mutex;
+		std::unordered_map<std::string, std::shared_ptr<const ResultFields>, SignatureHash, std::equal_to<>> m_resultFields;
+		std::atomic<unsigned long long> m_hits = 0;
+		std::atomic<unsigned long long> m_misses = 0;
+
+		ResultFieldsCache() = default;
+		static void buildSignature(const PGresult* statementResult, std::string& signature);
+	};
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+	enum class ResultFormat {
+		TEXT = 0,
+		BINARY = 1
+	};
+}
@@ -0,0 +1,99 @@
+#include "stdafx.h"
+#include "ResultStream.h"
+
+namespace systelab::db::postgresql {
+
+	ResultStream::ResultStream(PGconn* connection, BusyConnectionLock lock,
+							   const std::string& query, ResultFormat resultFormat)
+		: m_connection(connection)
+		, m_lock(std::move(lock))
+		, m_currentResult(utils::createRAIIPGresult(nullptr))
+		, m_fetchedRowsCount(0)
+		, m_finished(false)
+	{
+		const int sent = (resultFormat == ResultFormat::TEXT) ?
+			PQsendQuery(m_connection, query.c_str()) :
+			PQsendQueryParams(m_connection, query.c_str(), 0, nullptr, nullptr, nullptr, nullptr, static_cast<int>(resultFormat));
+		if (sent == 0)
+		{
+			throw std::runtime_error(std::string("Unable to send streaming query: ") + PQerrorMessage(m_connection));
+		}
+
+		if (PQsetSingleRowMode(m_connection) == 0)
+		{
+			finish();
+			throw std::runtime_error("Unable to activate single-row mode");
+		}
+
+		nextRow();
+	}
+
+	ResultStream::~ResultStream()
+	{
+		if (!m_finished)
+		{
+			cancel();
+			finish();
+		}
+	}
+
+	const PGresult* ResultStream::getCurrentResult() const
+	{
+		return m_currentResult.get();
+	}
+
+	bool ResultStream::hasCurrentRow() const
+	{
+		return m_currentResult && PQresultStatus(m_currentResult.get()) == PGRES_SINGLE_TUPLE;
+	}
+
+	unsigned int ResultStream::getFetchedRowsCount() const
+	{
+		return m_fetchedRowsCount;
+	}
+
+	void ResultStream::nextRow()
+	{
+		if (m_finished)
+		{
+			return;
+		}
+
+		// The last result of the query has no rows but keeps the description of the columns
+		m_currentResult = utils::createRAIIPGresult(PQgetResult(m_connection));
+		const auto status = PQresultStatus(m_currentResult.get());
+		if (status == PGRES_SINGLE_TUPLE)
+		{
+			m_fetchedRowsCount++;
+			return;
+		}
+
+		finish();
+		if (status != PGRES_TUPLES_OK)
+		{
+			utils::throwPostgressException(m_currentResult.get());
+		}
+	}
+
+	void ResultStream::finish()
+	{
+		while (PGresult* pendingResult = PQgetResult(m_connection))
+		{
+			PQclear(pendingResult);
+		}
+
+		m_finished = true;
+		m_lock.unlock();
+	}
+
+	void ResultStream::cancel()
+	{
+		PGcancel* cancelRequest = PQgetCancel(m_connection);
+		if (cancelRequest)
+		{
+			char errorBuffer[256];
+			PQcancel(cancelRequest, errorBuffer, sizeof(errorBuffer));
+			PQfreeCancel(cancelRequest);
+		}
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BusyConnectionLock.h"
+#include "PostgresUtils.h"
+#include "ResultFormat.h"
+
+typedef struct pg_conn PGconn;
+
+namespace systelab::db::postgresql {
+
+	// Retrieves the rows of a query one by one using the libpq single-row mode.
+	// The connection is kept locked and busy until all rows have been read or the stream is destroyed,
+	// so the stream must be used and destroyed on the thread that created it.
+	class ResultStream
+	{
+	public:
+		ResultStream(PGconn* connection, BusyConnectionLock lock,
+					 const std::string& query, ResultFormat resultFormat);
+		~ResultStream();
+
+		const PGresult* getCurrentResult() const;
+		bool hasCurrentRow() const;
+		unsigned int getFetchedRowsCount() const;
+
+		void nextRow();
+
+	private:
+		PGconn* m_connection;
+		BusyConnectionLock m_lock;
+		utils::PGResultRAII m_currentResult;
+		unsigned int m_fetchedRowsCount;
+		bool m_finished;
+
+		void finish();
+		void cancel();
+	};
+}
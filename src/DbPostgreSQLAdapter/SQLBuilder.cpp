@@ -0,0 +1,49 @@
+#include "stdafx.h"
+#include "SQLBuilder.h"
+
+namespace systelab::db::postgresql {
+
+	SQLBuilder::SQLBuilder(std::size_t reservedSize)
+	{
+		m_text.reserve(reservedSize);
+	}
+
+	SQLBuilder& SQLBuilder::getThreadBuilder()
+	{
+		thread_local SQLBuilder threadBuilder;
+		threadBuilder.clear();
+		return threadBuilder;
+	}
+
+	SQLBuilder& SQLBuilder::append(std::string_view text)
+	{
+		m_text.append(text);
+		return *this;
+	}
+
+	SQLBuilder& SQLBuilder::append(char character)
+	{
+		m_text.push_back(character);
+		return *this;
+	}
+
+	SQLBuilder& SQLBuilder::appendParameter(std::size_t parameterNumber)
+	{
+		return append('$').appendNumber(parameterNumber);
+	}
+
+	void SQLBuilder::clear()
+	{
+		m_text.clear();
+	}
+
+	const std::string& SQLBuilder::getText() const
+	{
+		return m_text;
+	}
+
+	std::string SQLBuilder::releaseText()
+	{
+		return std::move(m_text);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace systelab::db::postgresql {
+
+	// Appends statement text to a buffer reserved up front, formatting numbers with std::to_chars
+	class SQLBuilder
+	{
+	public:
+		SQLBuilder(std::size_t reservedSize = DEFAULT_RESERVED_SIZE);
+		~SQLBuilder() = default;
+
+		// Emptied builder of the calling thread. Its text is valid until the next call on the same thread.
+		static SQLBuilder& getThreadBuilder();
+
+		SQLBuilder& append(std::string_view text);
+		SQLBuilder& append(char character);
+		SQLBuilder& appendParameter(std::size_t parameterNumber);
+
+		template<typename Number>
+		SQLBuilder& appendNumber(Number value)
+		{
+			std::array<char, MAX_NUMBER_LENGTH> buffer;
+			const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+			return append(std::string_view(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data())));
+		}
+
+		template<typename Items, typename ItemAppender>
+		SQLBuilder& appendList(const Items& items, std::string_view separator, ItemAppender itemAppender)
+		{
+			bool firstItem = true;
+			for (const auto& item : items)
+			{
+				if (!firstItem)
+				{
+					append(separator);
+				}
+
+				itemAppender(*this, item);
+				firstItem = false;
+			}
+
+			return *this;
+		}
+
+		void clear();
+		const std::string& getText() const;
+		std::string releaseText();
+
+	private:
+		static const std::size_t DEFAULT_RESERVED_SIZE = 256;
+		static const std::size_t MAX_NUMBER_LENGTH = 32;
+
+		std::string m_text;
+	};
+}
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+#include "SchemaCache.h"
+
+namespace systelab::db::postgresql {
+
+	SchemaCache& SchemaCache::getInstance()
+	{
+		static SchemaCache instance;
+		return instance;
+	}
+
+	std::shared_ptr<const SchemaCache::TableSchema> SchemaCache::getTableSchema(const std::string& databaseKey,
+																				unsigned int relationOID,
+																				const std::function<TableSchema()>& loader)
+	{
+		unsigned long long loadVersion = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			const DatabaseSchemas& databaseSchemas = m_databases[databaseKey];
+			const auto relationIterator = databaseSchemas.relations.find(relationOID);
+			if (relationIterator != databaseSchemas.relations.cend())
+			{
+				m_statistics.hits++;
+				return relationIterator->second;
+			}
+
+			m_statistics.misses++;
+			loadVersion = databaseSchemas.version;
+		}
+
+		// Catalog query runs without holding the lock so other connections are not blocked on the network
+		return addTableSchema(databaseKey, loader(), loadVersion);
+	}
+
+	std::shared_ptr<const SchemaCache::TableSchema> SchemaCache::addTableSchema(const std::string& databaseKey,
+																				TableSchema tableSchema,
+																				unsigned long long loadVersion)
+	{
+		auto loadedSchema = std::make_shared<const TableSchema>(std::move(tableSchema));
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		DatabaseSchemas& databaseSchemas = m_databases[databaseKey];
+		// An invalidation received while loading means the loaded schema may already be stale
+		if (databaseSchemas.version == loadVersion)
+		{
+			databaseSchemas.relations[loadedSchema->relationOID] = loadedSchema;
+		}
+
+		return loadedSchema;
+	}
+
+	void SchemaCache::invalidate()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& databaseSchemas : m_databases)
+		{
+			clear(databaseSchemas.second);
+		}
+	}
+
+	void SchemaCache::invalidate(const std::string& databaseKey)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		clear(m_databases[databaseKey]);
+	}
+
+	unsigned long long SchemaCache::getVersion(const std::string& databaseKey) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto databaseIterator = m_databases.find(databaseKey);
+		return (databaseIterator != m_databases.cend()) ? databaseIterator->second.version : 0;
+	}
+
+	SchemaCache::Statistics SchemaCache::getStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Statistics statistics = m_statistics;
+		statistics.size = 0;
+		for (const auto& databaseSchemas : m_databases)
+		{
+			statistics.size += static_cast<unsigned int>(databaseSchemas.second.relations.size());
+		}
+
+		return statistics;
+	}
+
+	void SchemaCache::clear(DatabaseSchemas& databaseSchemas)
+	{
+		databaseSchemas.version++;
+		databaseSchemas.relations.clear();
+		m_statistics.invalidations++;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DbAdapterInterface/Types.h"
+
+#include "DefaultOID.h"
+
+namespace systelab::db::postgresql {
+
+	class SchemaCache
+	{
+	public:
+		struct ColumnDefinition
+		{
+			std::string name;
+			FieldTypes type;
+			PostgresqlOID typeOID;
+			std::string defaultValue;
+			bool primaryKey = false;
+		};
+
+		struct TableSchema
+		{
+			unsigned int relationOID = 0;
+			std::vector<ColumnDefinition> columns;
+		};
+
+		struct Statistics
+		{
+			unsigned long long hits = 0;
+			unsigned long long misses = 0;
+			unsigned long long invalidations = 0;
+			unsigned int size = 0;
+		};
+
+		static SchemaCache& getInstance();
+
+		// Schemas are looked up by the OID the table name resolves to on the requesting connection, as the
+		// same name may refer to different relations depending on the search_path
+		std::shared_ptr<const TableSchema> getTableSchema(const std::string& databaseKey,
+														  unsigned int relationOID,
+														  const std::function<TableSchema()>& loader);
+		std::shared_ptr<const TableSchema> addTableSchema(const std::string& databaseKey,
+														  TableSchema tableSchema,
+														  unsigned long long loadVersion);
+
+		void invalidate();
+		void invalidate(const std::string& databaseKey);
+		unsigned long long getVersion(const std::string& databaseKey) const;
+		Statistics getStatistics() const;
+
+	private:
+		struct DatabaseSchemas
+		{
+			unsigned long long version = 0;
+			std::map<unsigned int, std::shared_ptr<const TableSchema>> relations;
+		};
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, DatabaseSchemas> m_databases;
+		Statistics m_statistics;
+
+		SchemaCache() = default;
+		void clear(DatabaseSchemas& databaseSchemas);
+	};
+}
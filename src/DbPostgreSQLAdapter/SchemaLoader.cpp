@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "SchemaLoader.h"
+
+#include "Database.h"
+#include "PostgresUtils.h"
+#include "TypeRegistry.h"
+
+#include "DbAdapterInterface/IFieldValue.h"
+#include "DbAdapterInterface/IRecord.h"
+#include "DbAdapterInterface/IRecordSet.h"
+
+namespace systelab::db::postgresql::utils {
+
+	namespace {
+		const std::string COLUMNS_QUERY_SELECT = "SELECT a.attrelid::integer AS relation_oid, a.attname, a.atttypid::regtype, a.atttypid::integer AS type_oid, "
+												 "pg_get_expr(b.adbin, b.adrelid) AS default_value, c.indisprimary ";
+		const std::string COLUMNS_QUERY_JOINS = "LEFT JOIN pg_attrdef b ON (a.attrelid, a.attnum) = (b.adrelid, b.adnum) "
+												"LEFT JOIN pg_index c ON a.attrelid = c.indrelid "
+												"AND c.indisprimary "
+												"AND a.attnum = ANY(c.indkey) ";
+
+		SchemaCache::ColumnDefinition getColumnDefinition(const IRecord& record)
+		{
+			SchemaCache::ColumnDefinition column;
+			column.name = record.getFieldValue("attname").getStringValue();
+			column.typeOID = static_cast<PostgresqlOID>(record.getFieldValue("type_oid").getIntValue());
+			const TypeHandler* typeHandler = TypeRegistry::getInstance().findHandler(column.typeOID);
+			if (typeHandler == nullptr)
+			{
+				std::string excMessage = "Postgress type name not recognized: " + record.getFieldValue("atttypid").getStringValue();
+				throw std::runtime_error(excMessage);
+			}
+
+			column.type = typeHandler->fieldType;
+
+			const auto& isPrimaryKeyValue = record.getFieldValue("indisprimary");
+			if (!isPrimaryKeyValue.isNull())
+			{
+				column.primaryKey = isPrimaryKeyValue.getBooleanValue();
+			}
+
+			column.defaultValue = "NULL";
+			if (!record.getFieldValue("default_value").isNull())
+			{
+				column.defaultValue = record.getFieldValue("default_value").getStringValue();
+				if (column.type == STRING || column.type == DATETIME || column.type == BINARY)
+				{
+					column.defaultValue = column.defaultValue.substr(1, column.defaultValue.find('\'', 1) -1);
+				}
+			}
+
+			return column;
+		}
+	}
+
+	unsigned int resolveRelationOID(Database& database, const std::string& tableName)
+	{
+		const std::string query = "SELECT to_regclass(" + getStringLiteral(tableName) + ")::oid::integer AS relation_oid";
+		std::unique_ptr<IRecordSet> relationRecordSet = database.executeQuery(query, ResultFormat::TEXT);
+		const IFieldValue& relationOIDValue = relationRecordSet->getCurrentRecord().getFieldValue("relation_oid");
+		if (relationOIDValue.isNull())
+		{
+			std::string excMessage = "Table " + tableName + " doesn't exist in database.";
+			throw std::runtime_error(excMessage);
+		}
+
+		return static_cast<unsigned int>(relationOIDValue.getIntValue());
+	}
+
+	SchemaCache::TableSchema loadTableSchema(Database& database, unsigned int relationOID)
+	{
+		std::string query = COLUMNS_QUERY_SELECT +
+							"FROM pg_attribute a " +
+							COLUMNS_QUERY_JOINS +
+							"WHERE a.attrelid = " + std::to_string(relationOID) + " "
+							"AND a.attnum > 0 "
+							"AND NOT a.attisdropped "
+							"ORDER BY a.attnum";
+
+		std::unique_ptr<IRecordSet> fieldsRecordSet = database.executeQuery(query, ResultFormat::TEXT);
+
+		SchemaCache::TableSchema tableSchema;
+		while (fieldsRecordSet->isCurrentRecordValid())
+		{
+			const IRecord& record = fieldsRecordSet->getCurrentRecord();
+			tableSchema.relationOID = static_cast<unsigned int>(record.getFieldValue("relation_oid").getIntValue());
+			tableSchema.columns.push_back(getColumnDefinition(record));
+			fieldsRecordSet->nextRecord();
+		}
+
+		if (tableSchema.columns.empty())
+		{
+			std::string excMessage = "Table with OID " + std::to_string(relationOID) + " doesn't exist in database.";
+			throw std::runtime_error(excMessage);
+		}
+
+		return tableSchema;
+	}
+
+	std::map<unsigned int, SchemaTable> loadSchemaTables(Database& database, const std::string& schemaName)
+	{
+		std::string query = COLUMNS_QUERY_SELECT + ", "
+							"quote_ident(n.nspname) || '.' || quote_ident(r.relname) AS table_name, "
+							"quote_ident(r.relname) AS unqualified_table_name, pg_table_is_visible(r.oid) AS visible "
+							"FROM pg_class r "
+							"JOIN pg_namespace n ON n.oid = r.relnamespace "
+							"JOIN pg_attribute a ON a.attrelid = r.oid " +
+							COLUMNS_QUERY_JOINS +
+							"WHERE n.nspname = " + getStringLiteral(schemaName) + " "
+							"AND r.relkind IN ('r', 'p') "
+							"AND a.attnum > 0 "
+							"AND NOT a.attisdropped "
+							"ORDER BY r.oid, a.attnum";
+
+		std::unique_ptr<IRecordSet> fieldsRecordSet = database.executeQuery(query, ResultFormat::TEXT);
+
+		std::map<unsigned int, SchemaTable> schemaTables;
+		std::set<unsigned int> unsupportedTables;
+		while (fieldsRecordSet->isCurrentRecordValid())
+		{
+			const IRecord& record = fieldsRecordSet->getCurrentRecord();
+			const auto relationOID = static_cast<unsigned int>(record.getFieldValue("relation_oid").getIntValue());
+			SchemaTable& schemaTable = schemaTables[relationOID];
+			if (schemaTable.names.empty())
+			{
+				schemaTable.names.push_back(record.getFieldValue("table_name").getStringValue());
+				if (record.getFieldValue("visible").getBooleanValue())
+				{
+					schemaTable.names.push_back(record.getFieldValue("unqualified_table_name").getStringValue());
+				}
+			}
+
+			try
+			{
+				schemaTable.schema.relationOID = relationOID;
+				schemaTable.schema.columns.push_back(getColumnDefinition(record));
+			}
+			catch (std::runtime_error&)
+			{
+				// Tables with column types not handled by the adapter are left to fail when explicitly requested
+				unsupportedTables.insert(relationOID);
+			}
+
+			fieldsRecordSet->nextRecord();
+		}
+
+		for (const auto& unsupportedTable : unsupportedTables)
+		{
+			schemaTables.erase(unsupportedTable);
+		}
+
+		return schemaTables;
+	}
+}
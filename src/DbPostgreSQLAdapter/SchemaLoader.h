@@ -0,0 +1,23 @@
+#pragma once
+
+#include "SchemaCache.h"
+
+namespace systelab::db::postgresql {
+	class Database;
+}
+
+namespace systelab::db::postgresql::utils {
+
+	struct SchemaTable
+	{
+		// Schema qualified name, followed by the unqualified one when the table is visible through the search_path
+		std::vector<std::string> names;
+		SchemaCache::TableSchema schema;
+	};
+
+	// Resolves the table name with the search_path of the connection
+	unsigned int resolveRelationOID(Database& database, const std::string& tableName);
+	SchemaCache::TableSchema loadTableSchema(Database& database, unsigned int relationOID);
+	// Tables are keyed by relation OID
+	std::map<unsigned int, SchemaTable> loadSchemaTables(Database& database, const std::string& schemaName);
+}
@@ -0,0 +1,155 @@
+#include "stdafx.h"
+#include "StatementParameters.h"
+
+#include "DbAdapterInterface/IBinaryValue.h"
+#include "DbAdapterInterface/IField.h"
+#include "DbAdapterInterface/IFieldValue.h"
+#include "BinaryValue.h"
+#include "FieldValue.h"
+#include "PostgresUtils.h"
+
+namespace systelab::db::postgresql {
+
+	void StatementParameters::reserve(std::size_t count)
+	{
+		m_values.reserve(count);
+		m_valuePointers.reserve(count);
+	}
+
+	void StatementParameters::addNull()
+	{
+		m_values.push_back(std::nullopt);
+	}
+
+	void StatementParameters::addText(const std::string& value)
+	{
+		m_values.push_back(value);
+	}
+
+	void StatementParameters::addBinary(std::string&& value)
+	{
+		setBinaryFormat(m_values.size());
+		m_values.push_back(std::move(value));
+	}
+
+	void StatementParameters::addBorrowedBinary(std::string_view value)
+	{
+		setBinaryFormat(m_values.size());
+		m_borrowedValues.emplace_back(m_values.size(), value);
+		m_values.emplace_back(std::in_place);
+	}
+
+	void StatementParameters::addFieldValue(const IFieldValue& fieldValue)
+	{
+		if (fieldValue.isNull())
+		{
+			addNull();
+			return;
+		}
+
+		const FieldTypes fieldType = fieldValue.getField().getType();
+		switch (fieldType)
+		{
+			case BOOLEAN:
+				addText(fieldValue.getBooleanValue() ? "true" : "false");
+				break;
+			case INT:
+				addText(std::to_string(utils::getBigIntValue(fieldValue)));
+				break;
+			case DOUBLE:
+			{
+				// Shortest representation that reads back as the same double, as COPY and binary parameters send it
+				std::array<char, 32> buffer;
+				const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), fieldValue.getDoubleValue());
+				m_values.emplace_back(std::in_place, buffer.data(), result.ptr);
+			}
+			break;
+			case STRING:
+				addText(fieldValue.getStringValue());
+				break;
+			case DATETIME:
+				addText(utils::dateTimeToISOString(fieldValue.getDateTimeValue()));
+				break;
+			case BINARY:
+			{
+				// Values held in memory are sent straight from their buffer, with no escaping
+				const IBinaryValue& binaryValue = fieldValue.getBinaryValue();
+				const auto* ownedBinaryValue = dynamic_cast<const BinaryValue*>(&binaryValue);
+				if (ownedBinaryValue)
+				{
+					addBorrowedBinary(ownedBinaryValue->getData());
+				}
+				else
+				{
+					std::istream inputStream = binaryValue.getInputStream();
+					addBinary(std::string(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>()));
+				}
+			}
+			break;
+			default:
+				throw std::runtime_error("Invalid record field type.");
+				break;
+		}
+	}
+
+	unsigned int StatementParameters::getCount() const
+	{
+		return static_cast<unsigned int>(m_values.size());
+	}
+
+	const char* const* StatementParameters::getValues() const
+	{
+		m_valuePointers.clear();
+		for (const auto& value : m_values)
+		{
+			m_valuePointers.push_back(value ? value->c_str() : nullptr);
+		}
+
+		for (const auto& [index, value] : m_borrowedValues)
+		{
+			// Empty values are told apart from nulls by their pointer
+			m_valuePointers[index] = value.empty() ? "" : value.data();
+		}
+
+		return m_valuePointers.data();
+	}
+
+	const int* StatementParameters::getLengths() const
+	{
+		if (m_formats.empty())
+		{
+			return nullptr;
+		}
+
+		m_lengths.clear();
+		for (const auto& value : m_values)
+		{
+			m_lengths.push_back(value ? static_cast<int>(value->size()) : 0);
+		}
+
+		for (const auto& [index, value] : m_borrowedValues)
+		{
+			m_lengths[index] = static_cast<int>(value.size());
+		}
+
+		return m_lengths.data();
+	}
+
+	const int* StatementParameters::getFormats() const
+	{
+		if (m_formats.empty())
+		{
+			return nullptr;
+		}
+
+		// Text parameters added after the last binary one still need their format
+		m_formats.resize(m_values.size(), TEXT_FORMAT);
+		return m_formats.data();
+	}
+
+	void StatementParameters::setBinaryFormat(std::size_t index)
+	{
+		m_formats.resize(index + 1, TEXT_FORMAT);
+		m_formats[index] = BINARY_FORMAT;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+namespace systelab::db {
+	class IFieldValue;
+}
+
+namespace systelab::db::postgresql {
+
+	// Values of the parameters of a statement, in text format except for bytea values that are sent in
+	// binary format. Borrowed values must outlive the execution of the statement
+	class StatementParameters
+	{
+	public:
+		StatementParameters() = default;
+		~StatementParameters() = default;
+
+		void reserve(std::size_t count);
+
+		void addNull();
+		void addText(const std::string& value);
+		void addBinary(std::string&& value);
+		void addBorrowedBinary(std::string_view value);
+		void addFieldValue(const IFieldValue& fieldValue);
+
+		unsigned int getCount() const;
+		const char* const* getValues() const;
+		// Null while all the parameters are in text format, as libpq expects then
+		const int* getLengths() const;
+		const int* getFormats() const;
+
+	private:
+		static constexpr int TEXT_FORMAT = 0;
+		static constexpr int BINARY_FORMAT = 1;
+
+		std::vector<std::optional<std::string>> m_values;
+		std::vector<std::pair<std::size_t, std::string_view>> m_borrowedValues;
+		mutable std::vector<int> m_formats;
+		mutable std::vector<const char*> m_valuePointers;
+		mutable std::vector<int> m_lengths;
+
+		void setBinaryFormat(std::size_t index);
+	};
+}
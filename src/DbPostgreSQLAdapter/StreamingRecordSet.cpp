@@ -0,0 +1,79 @@
+#include "stdafx.h"
+#include "StreamingRecordSet.h"
+
+#include "Record.h"
+#include "ResultFields.h"
+#include "ResultFieldsCache.h"
+#include "ResultStream.h"
+
+#include "DbAdapterInterface/IFieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	StreamingRecordSet::StreamingRecordSet(std::unique_ptr<ResultStream> resultStream)
+		: m_resultStream(std::move(resultStream))
+	{
+		m_resultFields = ResultFieldsCache::getInstance().getResultFields(m_resultStream->getCurrentResult());
+		m_fieldNameIndex = m_resultFields->getFieldNameIndex();
+		loadCurrentRecord();
+	}
+
+	StreamingRecordSet::~StreamingRecordSet() = default;
+
+	unsigned int StreamingRecordSet::getFieldsCount() const
+	{
+		return m_resultFields->getFieldsCount();
+	}
+
+	const IField& StreamingRecordSet::getField(unsigned int index) const
+	{
+		return m_resultFields->getField(index);
+	}
+
+	const IField& StreamingRecordSet::getField(const std::string& fieldName) const
+	{
+		return m_resultFields->getField(fieldName);
+	}
+
+	unsigned int StreamingRecordSet::getRecordsCount() const
+	{
+		return m_resultStream->getFetchedRowsCount();
+	}
+
+	const IRecord& StreamingRecordSet::getCurrentRecord() const
+	{
+		return *m_currentRecord;
+	}
+
+	std::unique_ptr<IRecord> StreamingRecordSet::copyCurrentRecord() const
+	{
+		std::vector<std::unique_ptr<IFieldValue>> copiedFieldValues;
+		const unsigned int nFieldValues = m_currentRecord->getFieldValuesCount();
+		for (unsigned int i = 0; i < nFieldValues; i++)
+		{
+			copiedFieldValues.push_back(m_currentRecord->getFieldValue(i).clone());
+		}
+
+		return std::make_unique<Record>(copiedFieldValues, m_fieldNameIndex);
+	}
+
+	bool StreamingRecordSet::isCurrentRecordValid() const
+	{
+		return (m_currentRecord != nullptr);
+	}
+
+	void StreamingRecordSet::nextRecord()
+	{
+		m_currentRecord.reset();
+		m_resultStream->nextRow();
+		loadCurrentRecord();
+	}
+
+	void StreamingRecordSet::loadCurrentRecord()
+	{
+		if (m_resultStream->hasCurrentRow())
+		{
+			m_currentRecord = std::make_unique<Record>(*this, m_resultStream->getCurrentResult(), 0, m_fieldNameIndex);
+		}
+	}
+}
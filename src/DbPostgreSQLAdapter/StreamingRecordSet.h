@@ -0,0 +1,43 @@
+#pragma once
+
+#include "DbAdapterInterface/IRecordSet.h"
+
+#include "FieldNameIndex.h"
+
+namespace systelab::db {
+	class IField;
+	class IRecord;
+}
+
+namespace systelab::db::postgresql {
+
+	class ResultFields;
+	class ResultStream;
+
+	// Only the current record is decoded. getRecordsCount() returns the number of records fetched so far.
+	class StreamingRecordSet : public IRecordSet
+	{
+	public:
+		StreamingRecordSet(std::unique_ptr<ResultStream> resultStream);
+		~StreamingRecordSet() override;
+
+		unsigned int getFieldsCount() const override;
+		const IField& getField(unsigned int index) const override;
+		const IField& getField(const std::string& fieldName) const override;
+
+		unsigned int getRecordsCount() const override;
+
+		const IRecord& getCurrentRecord() const override;
+		std::unique_ptr<IRecord> copyCurrentRecord() const override;
+		bool isCurrentRecordValid() const override;
+		void nextRecord() override;
+
+	private:
+		std::unique_ptr<ResultStream> m_resultStream;
+		std::shared_ptr<const ResultFields> m_resultFields;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::unique_ptr<IRecord> m_currentRecord;
+
+		void loadCurrentRecord();
+	};
+}
@@ -0,0 +1,82 @@
+#include "stdafx.h"
+#include "StreamingTableRecordSet.h"
+
+#include "ResultStream.h"
+#include "TableRecord.h"
+
+#include "DbAdapterInterface/ITable.h"
+
+namespace systelab::db::postgresql {
+
+	StreamingTableRecordSet::StreamingTableRecordSet(ITable& table, std::unique_ptr<ResultStream> resultStream)
+		: m_table(table)
+		, m_fieldNameIndex(FieldNameIndex::getTableIndex(table))
+		, m_resultStream(std::move(resultStream))
+	{
+		loadCurrentRecord();
+	}
+
+	StreamingTableRecordSet::~StreamingTableRecordSet() = default;
+
+	ITable& StreamingTableRecordSet::getTable() const
+	{
+		return m_table;
+	}
+
+	unsigned int StreamingTableRecordSet::getFieldsCount() const
+	{
+		return m_table.getFieldsCount();
+	}
+
+	const IField& StreamingTableRecordSet::getField(unsigned int index) const
+	{
+		return m_table.getField(index);
+	}
+
+	const IField& StreamingTableRecordSet::getField(const std::string& fieldName) const
+	{
+		return m_table.getField(fieldName);
+	}
+
+	unsigned int StreamingTableRecordSet::getRecordsCount() const
+	{
+		return m_resultStream->getFetchedRowsCount();
+	}
+
+	const ITableRecord& StreamingTableRecordSet::getCurrentRecord() const
+	{
+		return *m_currentRecord;
+	}
+
+	std::unique_ptr<ITableRecord> StreamingTableRecordSet::copyCurrentRecord() const
+	{
+		std::vector<std::unique_ptr<IFieldValue>> copiedFieldValues;
+		const unsigned int nFieldValues = m_currentRecord->getFieldValuesCount();
+		for (unsigned int i = 0; i < nFieldValues; i++)
+		{
+			copiedFieldValues.push_back(m_currentRecord->getFieldValue(i).clone());
+		}
+
+		return std::make_unique<TableRecord>(m_table, copiedFieldValues, m_fieldNameIndex);
+	}
+
+	bool StreamingTableRecordSet::isCurrentRecordValid() const
+	{
+		return (m_currentRecord != nullptr);
+	}
+
+	void StreamingTableRecordSet::nextRecord()
+	{
+		m_currentRecord.reset();
+		m_resultStream->nextRow();
+		loadCurrentRecord();
+	}
+
+	void StreamingTableRecordSet::loadCurrentRecord()
+	{
+		if (m_resultStream->hasCurrentRow())
+		{
+			m_currentRecord = std::make_unique<TableRecord>(*this, m_resultStream->getCurrentResult(), 0, m_fieldNameIndex);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "DbAdapterInterface/ITableRecordSet.h"
+
+#include "FieldNameIndex.h"
+
+namespace systelab::db {
+	class IField;
+	class ITable;
+	class ITableRecord;
+}
+
+namespace systelab::db::postgresql {
+	class ResultStream;
+
+	// Only the current record is decoded. getRecordsCount() returns the number of records fetched so far.
+	class StreamingTableRecordSet : public ITableRecordSet
+	{
+	public:
+		StreamingTableRecordSet(ITable& table, std::unique_ptr<ResultStream> resultStream);
+		~StreamingTableRecordSet() override;
+
+		ITable& getTable() const override;
+
+		unsigned int getFieldsCount() const override;
+		const IField& getField(unsigned int index) const override;
+		const IField& getField(const std::string& fieldName) const override;
+
+		unsigned int getRecordsCount() const override;
+
+		const ITableRecord& getCurrentRecord() const override;
+		std::unique_ptr<ITableRecord> copyCurrentRecord() const override;
+		bool isCurrentRecordValid() const override;
+		void nextRecord() override;
+
+	private:
+		ITable& m_table;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::unique_ptr<ResultStream> m_resultStream;
+		std::unique_ptr<ITableRecord> m_currentRecord;
+
+		void loadCurrentRecord();
+	};
+}
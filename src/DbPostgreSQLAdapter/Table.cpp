@@ -1,128 +1,111 @@
 #include "stdafx.h"
 #include "Table.h"
 
+#include "CopyInWriter.h"
 #include "Database.h"
 #include <DbAdapterInterface/IRecordSet.h>
 #include <DbAdapterInterface/IRecord.h>
 #include <DbAdapterInterface/IBinaryValue.h>
 #include "Field.h"
+#include "FieldNameIndex.h"
 #include "FieldValue.h"
 #include "PostgresUtils.h"
 #include "PrimaryKey.h"
 #include "PrimaryKeyValue.h"
+#include "SchemaCache.h"
+#include "SchemaLoader.h"
+#include "SQLBuilder.h"
+#include "StatementParameters.h"
 #include "TableRecord.h"
 
 namespace {
-	std::string getSQLValue(const systelab::db::IFieldValue& fieldValue, bool forComparison, bool forAssignment)
+	const std::size_t MAX_STATEMENT_PARAMETERS = 65535;
+
+	void appendConditionValues(const std::vector<const systelab::db::IFieldValue*>& conditionValues,
+							   systelab::db::postgresql::SQLBuilder& statementKey,
+							   systelab::db::postgresql::StatementParameters& parameters)
 	{
-		std::ostringstream fieldValueStream;
-		if (fieldValue.isNull())
+		for (const auto conditionValue : conditionValues)
 		{
-			if (forComparison)
+			statementKey.appendNumber(conditionValue->getField().getIndex());
+			if (conditionValue->isNull())
 			{
-				fieldValueStream << " IS ";
+				statementKey.append('n');
 			}
-			else if (forAssignment)
+			else
 			{
-				fieldValueStream << " = ";
+				parameters.addFieldValue(*conditionValue);
 			}
-
-			fieldValueStream << "NULL";
+			statementKey.append(',');
 		}
-		else
+	}
+
+	systelab::db::postgresql::StatementParameters getConditionParameters(const std::vector<systelab::db::IFieldValue*>& conditionValues)
+	{
+		systelab::db::postgresql::StatementParameters parameters;
+		parameters.reserve(conditionValues.size());
+		for (const auto conditionValue : conditionValues)
 		{
-			if (forComparison || forAssignment)
+			if (conditionValue->isNull() || conditionValue->isDefault())
 			{
-				fieldValueStream << " = ";
+				throw std::runtime_error("Can't bind NULL or default values of field " + conditionValue->getField().getName() +
+										 " as condition parameters, write the comparison in the condition template (e.g. IS NULL).");
 			}
 
-			const systelab::db::FieldTypes fieldType = fieldValue.getField().getType();
-			switch (fieldType)
-			{
-			case systelab::db::BOOLEAN:
-				fieldValueStream << (fieldValue.getBooleanValue() ? "True" : "False");
-				break;
-			case systelab::db::INT:
-				fieldValueStream << fieldValue.getIntValue();
-				break;
-			case systelab::db::DOUBLE:
-				fieldValueStream << std::setprecision(10) << fieldValue.getDoubleValue();
-				break;
-			case systelab::db::STRING:
-				fieldValueStream << "'" << fieldValue.getStringValue() << "'";
-				break;
-			case systelab::db::DATETIME:
-				fieldValueStream << "'" << systelab::db::postgresql::utils::dateTimeToISOString(fieldValue.getDateTimeValue()) << "'";
-				break;
-			case systelab::db::BINARY:
-				throw std::runtime_error("Insert of tables with binary fields not implemented.");
-				break;
-			default:
-				throw std::runtime_error("Invalid record field type.");
-				break;
-			}
+			parameters.addFieldValue(*conditionValue);
 		}
 
-		return fieldValueStream.str();
+		return parameters;
 	}
 
-	std::string getStringList(const std::vector<std::string>& items, const std::string& separator)
+	void appendConditionSQL(systelab::db::postgresql::SQLBuilder& sql,
+							const std::vector<const systelab::db::IFieldValue*>& conditionValues,
+							unsigned int firstParameterNumber)
 	{
-		std::string stringList = "";
-		if (!items.empty())
-		{
-			stringList = std::accumulate(items.begin()+1, items.end(), items.at(0),
-				[&separator](const std::string& a, const std::string& b)
+		unsigned int parameterNumber = firstParameterNumber;
+		sql.appendList(conditionValues, " AND ",
+			[&parameterNumber](systelab::db::postgresql::SQLBuilder& builder, const systelab::db::IFieldValue* conditionValue)
+			{
+				builder.append(conditionValue->getField().getName());
+				if (conditionValue->isNull())
 				{
-					return a + separator + b;
-				});
-		}
-
-		return stringList;
+					builder.append(" IS NULL");
+				}
+				else
+				{
+					builder.append(" = ").appendParameter(parameterNumber++);
+				}
+			});
 	}
 
-	systelab::db::FieldTypes getTypeFromPostgresTypeName(std::string postgresTypeName)
+	void appendValuesRowSQL(systelab::db::postgresql::SQLBuilder& sql, std::size_t columnsCount, std::size_t firstParameterNumber)
 	{
-		if (postgresTypeName == "boolean")
-		{
-			return systelab::db::BOOLEAN;
-		}
-		else if (postgresTypeName == "integer")
-		{
-			return systelab::db::INT;
-		}
-		else if (postgresTypeName == "real")
-		{
-			return systelab::db::DOUBLE;
-		}
-		else if (postgresTypeName == "text" ||
-				 postgresTypeName == "character" ||
-			     postgresTypeName == "character varying")
+		sql.append('(');
+		for (std::size_t i = 0; i < columnsCount; i++)
 		{
-			return systelab::db::STRING;
-		}
-		else if (postgresTypeName == "timestamp with time zone")
-		{
-			return systelab::db::DATETIME;
-		}
-		else
-		{
-			std::string excMessage = "Postgress type name not recognized: " + postgresTypeName;
-			throw std::runtime_error(excMessage);
+			if (i > 0)
+			{
+				sql.append(',');
+			}
+
+			sql.appendParameter(firstParameterNumber + i);
 		}
+		sql.append(')');
 	}
 }
 
 namespace systelab::db::postgresql {
 
-	Table::Table(Database& database, const std::string& name)
+	Table::Table(Database& database, const std::string& name, unsigned int relationOID)
 		: m_database(database)
 		, m_name(name)
 	{
-		loadFields();
+		loadFields(relationOID);
 		m_primaryKey = std::make_unique<PrimaryKey>(*this);
 	}
 
+	Table::~Table() = default;
+
 	std::string Table::getName() const
 	{
 		return m_name;
@@ -145,15 +128,10 @@ namespace systelab::db::postgresql {
 
 	const IField& Table::getField(const std::string& fieldName) const
 	{
-		const auto field = std::ranges::find_if(m_fields,
-			[&fieldName](const auto& field)
-			{
-				return field->getName() == fieldName;
-			});
-
-		if (field != m_fields.cend())
+		const auto fieldIndex = m_fieldNameIndex->find(fieldName);
+		if (fieldIndex)
 		{
-			return *(field->get()); 
+			return *m_fields[*fieldIndex];
 		}
 
 		throw std::runtime_error("The requested field doesn't exist");
@@ -191,19 +169,28 @@ namespace systelab::db::postgresql {
 
 	std::unique_ptr<IFieldValue> Table::createFieldValue(const IField& field, std::unique_ptr<IBinaryValue> value) const
 	{
-		throw std::runtime_error("Not implemented yet");
+		return std::make_unique<FieldValue>(field, std::move(value));
 	}
 
 	std::unique_ptr<IPrimaryKeyValue> Table::createPrimaryKeyValue() const
 	{
-		const IPrimaryKey& primaryKey = getPrimaryKey();
-		return std::make_unique<PrimaryKeyValue>(primaryKey);
+		return std::make_unique<PrimaryKeyValue>(*m_primaryKey);
+	}
+
+	std::shared_ptr<const FieldNameIndex> Table::getFieldNameIndex() const
+	{
+		return m_fieldNameIndex;
 	}
 
 	std::unique_ptr<ITableRecordSet> Table::getAllRecords() const
+	{
+		return getAllRecords(RecordSetMode::MATERIALIZED);
+	}
+
+	std::unique_ptr<ITableRecordSet> Table::getAllRecords(RecordSetMode recordSetMode) const
 	{
 		std::string query = "SELECT * FROM " + m_name;
-		return m_database.executeTableQuery(query, const_cast<Table&>(*this));
+		return m_database.executeTableQuery(query, const_cast<Table&>(*this), recordSetMode);
 	}
 
 	std::unique_ptr<ITableRecord> Table::getRecordByPrimaryKey(const IPrimaryKeyValue& primaryKeyValue) const
@@ -234,7 +221,8 @@ namespace systelab::db::postgresql {
 
 	std::unique_ptr<ITableRecordSet> Table::filterRecordsByFields(const std::vector<IFieldValue*>& conditionValues, const IField* orderByField) const
 	{
-		std::vector<std::string> conditionValuesSQL;
+		std::vector<const IFieldValue*> conditionFieldValues;
+		conditionFieldValues.reserve(conditionValues.size());
 		unsigned int nConditionFieldValues = (unsigned int) conditionValues.size();
 		for (unsigned int j = 0; j < nConditionFieldValues; j++)
 		{
@@ -248,20 +236,34 @@ namespace systelab::db::postgresql {
 
 			if (!conditionFieldValue.isDefault())
 			{
-				std::string conditionFieldValueName = field.getName();
-				std::string conditionFieldValueSQLValue = getSQLValue(conditionFieldValue, true, false);
-				conditionValuesSQL.push_back( conditionFieldValueName + conditionFieldValueSQLValue );
+				conditionFieldValues.push_back(&conditionFieldValue);
 			}
 		}
 
-		std::string conditionSQLStr = getStringList(conditionValuesSQL, " AND ");
-
+		StatementParameters parameters;
+		parameters.reserve(conditionFieldValues.size());
+		SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+		statementKey.append("SELECT|").append(m_name).append('|');
+		appendConditionValues(conditionFieldValues, statementKey, parameters);
 		if (orderByField)
 		{
-			conditionSQLStr += " ORDER BY " + orderByField->getName();
+			statementKey.append('|').append(orderByField->getName());
 		}
 
-		return filterRecordsByCondition(conditionSQLStr);
+		return m_database.executePreparedTableQuery(statementKey.getText(),
+			[this, &conditionFieldValues, orderByField]()
+			{
+				SQLBuilder query;
+				query.append(m_selectFieldsSQL).append(" WHERE ");
+				appendConditionSQL(query, conditionFieldValues, 1);
+				if (orderByField)
+				{
+					query.append(" ORDER BY ").append(orderByField->getName());
+				}
+
+				return query.releaseText();
+			},
+			parameters, const_cast<Table&>(*this));
 	}
 
 	std::unique_ptr<ITableRecordSet> Table::filterRecordsByCondition(const std::string& SQLCondition) const
@@ -270,6 +272,21 @@ namespace systelab::db::postgresql {
 		return m_database.executeTableQuery(query, const_cast<Table&>(*this));
 	}
 
+	std::unique_ptr<ITableRecordSet> Table::filterRecordsByCondition(const std::string& conditionTemplate,
+																	 const std::vector<IFieldValue*>& conditionValues) const
+	{
+		const StatementParameters parameters = getConditionParameters(conditionValues);
+		SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+		statementKey.append("SELECT|").append(m_name).append("|WHERE ").append(conditionTemplate);
+
+		return m_database.executePreparedTableQuery(statementKey.getText(),
+			[this, &conditionTemplate]()
+			{
+				return m_selectFieldsSQL + " WHERE " + conditionTemplate;
+			},
+			parameters, const_cast<Table&>(*this));
+	}
+
 	int Table::getMaxFieldValueInt(const IField& field) const
 	{
 		const std::string query = "SELECT MAX(" + field.getName() + ") FROM " + m_name;
@@ -294,7 +311,7 @@ namespace systelab::db::postgresql {
 			fieldValues.push_back(std::move(fieldValue));
 		}
 
-		return std::make_unique<TableRecord>(const_cast<Table&>(*this), fieldValues);
+		return std::make_unique<TableRecord>(const_cast<Table&>(*this), fieldValues, m_fieldNameIndex);
 	}
 
 	std::unique_ptr<ITableRecord> Table::copyRecord(const ITableRecord& record) const
@@ -313,7 +330,7 @@ namespace systelab::db::postgresql {
 			copyFieldValues.push_back(std::move(copyFieldValue));
 		}
 
-		return std::make_unique<TableRecord>(const_cast<Table&>(*this), copyFieldValues);
+		return std::make_unique<TableRecord>(const_cast<Table&>(*this), copyFieldValues, m_fieldNameIndex);
 	}
 
 	RowsAffected Table::insertRecord(ITableRecord& record)
@@ -323,59 +340,133 @@ namespace systelab::db::postgresql {
 			throw std::runtime_error("Can't insert records from other tables." );
 		}
 
-		std::vector<std::string> fieldNamesSQL;
-		std::vector<std::string> fieldValuesSQL;
-		std::string primaryKey;
+		StatementParameters parameters;
+		SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+		statementKey.append("INSERT|").append(m_name).append('|');
 		const unsigned int fieldsValuesCount = record.getFieldValuesCount();
+		parameters.reserve(fieldsValuesCount);
 		for (unsigned int i= 0; i < fieldsValuesCount; i++)
 		{
 			const IFieldValue& fieldValue = record.getFieldValue(i);
 			const IField& field = fieldValue.getField();
 			if (!fieldValue.isDefault())
 			{
-				std::string fieldName = fieldValue.getField().getName();
-				fieldNamesSQL.push_back(fieldName);
-
-				std::string fieldValueSQL = getSQLValue(fieldValue, false, false);
-				fieldValuesSQL.push_back(fieldValueSQL);
+				parameters.addFieldValue(fieldValue);
+				statementKey.appendNumber(field.getIndex()).append(',');
 			}
+		}
+		statementKey.append('|').append(m_returnedPrimaryKeyName);
 
-			if (field.isPrimaryKey())
+		// Column names are only needed when the statement isn't prepared yet
+		const OperationResult operationResult = m_database.executePreparedOperation(statementKey.getText(),
+			[this, &record]()
 			{
-				primaryKey = fieldValue.getField().getName();
-			}
+				SQLBuilder statement;
+				statement.append("INSERT INTO ").append(m_name);
+				std::size_t columnsCount = 0;
+				const unsigned int fieldsValuesCount = record.getFieldValuesCount();
+				for (unsigned int i = 0; i < fieldsValuesCount; i++)
+				{
+					const IFieldValue& fieldValue = record.getFieldValue(i);
+					if (!fieldValue.isDefault())
+					{
+						statement.append((columnsCount++ > 0) ? "," : " (");
+						statement.append(fieldValue.getField().getName());
+					}
+				}
+
+				if (columnsCount > 0)
+				{
+					statement.append(") VALUES ");
+					appendValuesRowSQL(statement, columnsCount, 1);
+				}
+				else
+				{
+					statement.append(" DEFAULT VALUES");
+				}
+
+				if (!m_returnedPrimaryKeyName.empty())
+				{
+					statement.append(" RETURNING ").append(m_returnedPrimaryKeyName);
+				}
+
+				return statement.releaseText();
+			},
+			parameters);
+
+		if (operationResult.rowsAffected > 0 && !operationResult.returnedKeys.empty())
+		{
+			fillInsertedRecord(record, operationResult.returnedKeys.back());
 		}
 
-		std::string fieldNamesSQLStr = getStringList(fieldNamesSQL, ",");
-		std::string fieldValuesSQLStr = getStringList(fieldValuesSQL, ",");
-		std::string insert = "INSERT INTO " + m_name + 
-							 " (" + fieldNamesSQLStr + ") " +
-							 " VALUES (" + fieldValuesSQLStr + ") RETURNING " + primaryKey;
+		return operationResult.rowsAffected;
+	}
+
+	RowsAffected Table::insertRecordsInBatches(const std::vector<ITableRecord*>& records, unsigned int batchSize)
+	{
+		std::map<std::vector<const Field*>, std::vector<ITableRecord*>> recordsByColumns;
+		for (ITableRecord* record : records)
+		{
+			if (&record->getTable() != this)
+			{
+				throw std::runtime_error("Can't insert records from other tables." );
+			}
 
-		m_database.executeOperation(insert);
-		RowsAffected rows = m_database.getRowsAffectedByLastChangeOperation();
+			recordsByColumns[getInsertColumns(*record, false)].push_back(record);
+		}
 
-		if (rows > 0)
+		RowsAffected rows = 0;
+		for (const auto& [columns, columnsRecords] : recordsByColumns)
 		{
-			for (unsigned int j = 0; j < fieldsValuesCount; j++)
+			if (columns.empty())
 			{
-				IFieldValue& fieldValue = record.getFieldValue(j);
-				if (fieldValue.isDefault())
+				for (ITableRecord* record : columnsRecords)
 				{
-					const IField& field = fieldValue.getField();
-					if (field.isPrimaryKey())
-					{
-						RowId rowId = m_database.getLastInsertedRowId();
-						fieldValue.setIntValue(rowId);
-					}
-					else
-					{
-						fieldValue.useDefaultValue();
-					}
+					rows += insertRecord(*record);
 				}
+				continue;
+			}
+
+			const std::size_t maxBatchSize = std::max<std::size_t>(std::min<std::size_t>(batchSize, MAX_STATEMENT_PARAMETERS / columns.size()), 1);
+			for (std::size_t first = 0; first < columnsRecords.size(); first += maxBatchSize)
+			{
+				const std::size_t last = std::min(first + maxBatchSize, columnsRecords.size());
+				rows += insertBatch(columns, columnsRecords.cbegin() + first, columnsRecords.cbegin() + last);
+			}
+		}
+
+		return rows;
+	}
+
+	RowsAffected Table::insertRecords(const std::vector<ITableRecord*>& records, const CopyOptions& options)
+	{
+		for (const ITableRecord* record : records)
+		{
+			if (&record->getTable() != this)
+			{
+				throw std::runtime_error("Can't insert records from other tables." );
 			}
 		}
 
+		// A COPY needs the same columns for all its rows, so each run of records sharing the same default values is copied separately.
+		// Returned primary keys are always copied, so runs are also split on whether their keys have to be generated
+		RowsAffected rows = 0;
+		auto runBegin = records.cbegin();
+		while (runBegin != records.cend())
+		{
+			const std::vector<const Field*> columns = getInsertColumns(**runBegin, options.returnPrimaryKeys);
+			const bool defaultPrimaryKey = hasDefaultPrimaryKey(**runBegin);
+			const auto runEnd = std::find_if(runBegin + 1, records.cend(),
+				[this, &columns, defaultPrimaryKey, &options](const ITableRecord* record)
+				{
+					return hasDefaultPrimaryKey(*record) != defaultPrimaryKey ||
+						   getInsertColumns(*record, options.returnPrimaryKeys) != columns;
+				});
+
+			rows += copyRecords(runBegin, runEnd, columns, options);
+			runBegin = runEnd;
+		}
+
 		return rows;
 	}
 
@@ -400,6 +491,7 @@ namespace systelab::db::postgresql {
 
 		std::vector<IFieldValue*> newValues;
 		unsigned int nRecordFieldValues = record.getFieldValuesCount();
+		newValues.reserve(nRecordFieldValues);
 		for(unsigned int i = 0; i < nRecordFieldValues; i++)
 		{
 			IFieldValue& recordFieldValue = record.getFieldValue(i);
@@ -422,6 +514,7 @@ namespace systelab::db::postgresql {
 
 		std::vector<IFieldValue*> conditionValues;
 		unsigned int nPrimaryKeyFieldValues = primaryKeyValue.getFieldValuesCount();
+		conditionValues.reserve(nPrimaryKeyFieldValues);
 		for (unsigned int i = 0; i < nPrimaryKeyFieldValues; i++)
 		{
 			conditionValues.push_back( &primaryKeyValue.getFieldValue(i) );
@@ -470,7 +563,8 @@ namespace systelab::db::postgresql {
 
 	RowsAffected Table::updateRecordsByCondition(const std::vector<IFieldValue*>& newValues, const std::vector<IFieldValue*>& conditionValues)
 	{
-		std::vector<std::string> newValuesSQL;
+		std::vector<const IFieldValue*> newFieldValues;
+		newFieldValues.reserve(newValues.size());
 		unsigned int nNewFieldValues = (unsigned int) newValues.size();
 		for (unsigned int i = 0; i < nNewFieldValues; i++)
 		{
@@ -484,13 +578,12 @@ namespace systelab::db::postgresql {
 
 			if (!newFieldValue.isDefault())
 			{
-				std::string newFieldValueName = field.getName();
-				std::string newFieldValueSQLValue = getSQLValue(newFieldValue, false, true);
-				newValuesSQL.push_back( newFieldValueName + newFieldValueSQLValue );
+				newFieldValues.push_back(&newFieldValue);
 			}
 		}
 
-		std::vector<std::string> conditionValuesSQL;
+		std::vector<const IFieldValue*> conditionFieldValues;
+		conditionFieldValues.reserve(conditionValues.size());
 		unsigned int nConditionFieldValues = (unsigned int) conditionValues.size();
 		for (unsigned int j = 0; j < nConditionFieldValues; j++)
 		{
@@ -504,23 +597,43 @@ namespace systelab::db::postgresql {
 
 			if (!conditionFieldValue.isDefault())
 			{
-				std::string conditionFieldValueName = field.getName();
-				std::string conditionFieldValueSQLValue = getSQLValue(conditionFieldValue, true, false);
-				conditionValuesSQL.push_back( conditionFieldValueName + conditionFieldValueSQLValue );
+				conditionFieldValues.push_back(&conditionFieldValue);
 			}
 		}
 
-		if (!newValuesSQL.empty() && !conditionValuesSQL.empty())
+		if (!newFieldValues.empty() && !conditionFieldValues.empty())
 		{
-			std::string newValuesSQLStr = getStringList(newValuesSQL, ", ");
-			std::string conditionSQLStr = getStringList(conditionValuesSQL, " AND ");
+			StatementParameters parameters;
+			parameters.reserve(newFieldValues.size() + conditionFieldValues.size());
+			SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+			statementKey.append("UPDATE|").append(m_name).append('|');
+			for (const auto newFieldValue : newFieldValues)
+			{
+				statementKey.appendNumber(newFieldValue->getField().getIndex()).append(',');
+				parameters.addFieldValue(*newFieldValue);
+			}
 
-			std::string update = "UPDATE " + m_name + " " +
-								 "SET " + newValuesSQLStr + " " +
-								 "WHERE " + conditionSQLStr + ";";
+			statementKey.append('|');
+			appendConditionValues(conditionFieldValues, statementKey, parameters);
 
-			m_database.executeOperation(update);
-			return m_database.getRowsAffectedByLastChangeOperation();
+			return m_database.executePreparedOperation(statementKey.getText(),
+				[this, &newFieldValues, &conditionFieldValues]()
+				{
+					SQLBuilder statement;
+					unsigned int parameterNumber = 1;
+					statement.append("UPDATE ").append(m_name).append(" SET ");
+					statement.appendList(newFieldValues, ", ",
+						[&parameterNumber](SQLBuilder& builder, const IFieldValue* newFieldValue)
+						{
+							builder.append(newFieldValue->getField().getName()).append(" = ").appendParameter(parameterNumber++);
+						});
+
+					statement.append(" WHERE ");
+					appendConditionSQL(statement, conditionFieldValues, parameterNumber);
+					statement.append(';');
+					return statement.releaseText();
+				},
+				parameters).rowsAffected;
 		}
 		else
 		{
@@ -530,7 +643,7 @@ namespace systelab::db::postgresql {
 
 	RowsAffected Table::deleteRecordsByCondition(const std::vector<IFieldValue*>& conditionValues)
 	{
-		std::vector<std::string> conditionValuesSQL;
+		std::vector<const IFieldValue*> conditionFieldValues;
 		const unsigned int nConditionFieldValues = (unsigned int) conditionValues.size();
 		for (unsigned int i = 0; i < nConditionFieldValues; i++)
 		{
@@ -544,21 +657,28 @@ namespace systelab::db::postgresql {
 
 			if (!conditionFieldValue.isDefault())
 			{
-				std::string conditionFieldValueName = field.getName();
-				std::string conditionFieldValueSQLValue = getSQLValue(conditionFieldValue, true, false);
-				conditionValuesSQL.push_back( conditionFieldValueName + conditionFieldValueSQLValue );
+				conditionFieldValues.push_back(&conditionFieldValue);
 			}
 		}
 
-		if (!conditionValuesSQL.empty())
+		if (!conditionFieldValues.empty())
 		{
-			std::string conditionSQLStr = getStringList(conditionValuesSQL, " AND ");
-
-			std::string deleteSQL = "DELETE FROM " + m_name + " " +
-									"WHERE " + conditionSQLStr + ";";
+			StatementParameters parameters;
+			parameters.reserve(conditionFieldValues.size());
+			SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+			statementKey.append("DELETE|").append(m_name).append('|');
+			appendConditionValues(conditionFieldValues, statementKey, parameters);
 
-			m_database.executeOperation(deleteSQL);
-			return m_database.getRowsAffectedByLastChangeOperation();
+			return m_database.executePreparedOperation(statementKey.getText(),
+				[this, &conditionFieldValues]()
+				{
+					SQLBuilder statement;
+					statement.append("DELETE FROM ").append(m_name).append(" WHERE ");
+					appendConditionSQL(statement, conditionFieldValues, 1);
+					statement.append(';');
+					return statement.releaseText();
+				},
+				parameters).rowsAffected;
 		}
 		else
 		{
@@ -571,67 +691,280 @@ namespace systelab::db::postgresql {
 		std::string deleteSQL = "DELETE FROM " + m_name + " " +
 								"WHERE " + condition + ";";
 
-		m_database.executeOperation(deleteSQL);
-		return m_database.getRowsAffectedByLastChangeOperation();
+		return m_database.executeOperationWithResult(deleteSQL).rowsAffected;
+	}
+
+	RowsAffected Table::deleteRecordsByCondition(const std::string& conditionTemplate, const std::vector<IFieldValue*>& conditionValues)
+	{
+		const StatementParameters parameters = getConditionParameters(conditionValues);
+		SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+		statementKey.append("DELETE|").append(m_name).append("|WHERE ").append(conditionTemplate);
+
+		return m_database.executePreparedOperation(statementKey.getText(),
+			[this, &conditionTemplate]()
+			{
+				return "DELETE FROM " + m_name + " " +
+					   "WHERE " + conditionTemplate + ";";
+			},
+			parameters).rowsAffected;
 	}
 
 	RowsAffected Table::deleteAllRecords()
 	{
 		std::string deleteSQL = "DELETE FROM " + m_name + ";";
 
-		m_database.executeOperation(deleteSQL);
-		return m_database.getRowsAffectedByLastChangeOperation();
+		return m_database.executeOperationWithResult(deleteSQL).rowsAffected;
 	}
 
-	void Table::loadFields()
+	void Table::loadFields(unsigned int relationOID)
 	{
-		std::string query = "SELECT a.attname, a.atttypid::regtype, pg_get_expr(b.adbin, b.adrelid) AS default_value, c.indisprimary "
-							"FROM pg_attribute a "
-							"LEFT JOIN pg_attrdef b ON (a.attrelid, a.attnum) = (b.adrelid, b.adnum) "
-							"LEFT JOIN pg_index c ON a.attrelid = c.indrelid "
-							"AND a.attnum = ANY(c.indkey) "
-							"WHERE a.attrelid = '" + m_name + "'::regclass "
-							"AND a.attnum > 0 "
-							"AND NOT a.attisdropped";
-
-		std::unique_ptr<IRecordSet> fieldsRecordSet = m_database.executeQuery(query);
+		const auto tableSchema = SchemaCache::getInstance().getTableSchema(m_database.getSchemaCacheKey(), relationOID,
+			[this, relationOID]()
+			{
+				return utils::loadTableSchema(m_database, relationOID);
+			});
 
 		unsigned int i = 0;
-		while (fieldsRecordSet->isCurrentRecordValid())
+		for (const auto& column : tableSchema->columns)
 		{
-			const IRecord& record = fieldsRecordSet->getCurrentRecord();
-			std::string fieldName = record.getFieldValue("attname").getStringValue();
-			std::string fieldTypeName = record.getFieldValue("atttypid").getStringValue();
-			FieldTypes fieldType = getTypeFromPostgresTypeName(fieldTypeName);
-			const auto& isPrimaryKeyValue = record.getFieldValue("indisprimary");
-			bool fieldPK = false;
-			if (!isPrimaryKeyValue.isNull())
+			auto field = std::make_unique<Field>(i, column.name, column.type, column.defaultValue, column.primaryKey, column.typeOID);
+			if (column.primaryKey)
 			{
-				fieldPK = isPrimaryKeyValue.getBooleanValue();
+				m_returnedPrimaryKeyName = column.name;
 			}
 
-			std::string defaultValue = "NULL";
-			if (!record.getFieldValue("default_value").isNull())
+			m_fields.push_back(std::move(field));
+			i++;
+		}
+
+		m_fieldNameIndex = FieldNameIndex::create(m_fields);
+
+		SQLBuilder selectFieldsSQL;
+		selectFieldsSQL.append("SELECT ");
+		selectFieldsSQL.appendList(m_fields, ",",
+			[](SQLBuilder& builder, const std::unique_ptr<Field>& field)
 			{
-				defaultValue = record.getFieldValue("default_value").getStringValue();
-				if (fieldType == STRING || fieldType == DATETIME)
+				builder.append(field->getName());
+			});
+		selectFieldsSQL.append(" FROM ").append(m_name);
+		m_selectFieldsSQL = selectFieldsSQL.releaseText();
+	}
+
+	std::vector<const Field*> Table::getInsertColumns(const ITableRecord& record, bool includeDefaultPrimaryKey) const
+	{
+		std::vector<const Field*> columns;
+		const unsigned int fieldsValuesCount = record.getFieldValuesCount();
+		for (unsigned int i = 0; i < fieldsValuesCount; i++)
+		{
+			const IFieldValue& fieldValue = record.getFieldValue(i);
+			const IField& field = fieldValue.getField();
+			if (!fieldValue.isDefault() || (field.isPrimaryKey() && includeDefaultPrimaryKey))
+			{
+				columns.push_back(m_fields.at(field.getIndex()).get());
+			}
+		}
+
+		return columns;
+	}
+
+	bool Table::hasDefaultPrimaryKey(const ITableRecord& record) const
+	{
+		const unsigned int fieldsValuesCount = record.getFieldValuesCount();
+		for (unsigned int i = 0; i < fieldsValuesCount; i++)
+		{
+			const IFieldValue& fieldValue = record.getFieldValue(i);
+			if (fieldValue.getField().isPrimaryKey() && fieldValue.isDefault())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	RowsAffected Table::copyRecords(std::vector<ITableRecord*>::const_iterator recordsBegin,
+									std::vector<ITableRecord*>::const_iterator recordsEnd,
+									const std::vector<const Field*>& columns,
+									const CopyOptions& options)
+	{
+		// Records of a run either all have their primary key or all need it generated
+		const Field* generatedKeyField = nullptr;
+		std::vector<std::int64_t> generatedKeys;
+		if (options.returnPrimaryKeys && hasDefaultPrimaryKey(**recordsBegin))
+		{
+			const auto generatedKeyColumn = std::ranges::find_if(columns,
+				[&recordsBegin](const Field* column)
+				{
+					return column->isPrimaryKey() && (*recordsBegin)->getFieldValue(column->getIndex()).isDefault();
+				});
+
+			if (generatedKeyColumn != columns.cend())
+			{
+				if (m_primaryKey->getFieldsCount() != 1 || (*generatedKeyColumn)->getType() != INT)
 				{
-					defaultValue = defaultValue.substr(1, defaultValue.find('\'', 1) -1);
+					throw std::runtime_error("Generated primary keys can only be returned for a single integer primary key field.");
 				}
+
+				generatedKeyField = *generatedKeyColumn;
+				generatedKeys = reservePrimaryKeys(*generatedKeyField, std::distance(recordsBegin, recordsEnd));
 			}
+		}
 
-			auto field = std::make_unique<Field>(i, fieldName, fieldType, defaultValue, fieldPK);
-			m_fields.push_back( std::move(field));
+		std::unique_ptr<CopyInWriter> writer = m_database.startCopyIn(m_name, columns, options);
+		std::vector<const IFieldValue*> values(columns.size());
+		std::size_t recordIndex = 0;
+		for (auto recordIterator = recordsBegin; recordIterator != recordsEnd; ++recordIterator, ++recordIndex)
+		{
+			std::unique_ptr<IFieldValue> generatedKeyValue;
+			for (std::size_t i = 0; i < columns.size(); i++)
+			{
+				if (columns[i] == generatedKeyField)
+				{
+					generatedKeyValue = std::make_unique<FieldValue>(*generatedKeyField, generatedKeys[recordIndex]);
+					values[i] = generatedKeyValue.get();
+				}
+				else
+				{
+					values[i] = &(*recordIterator)->getFieldValue(columns[i]->getIndex());
+				}
+			}
 
-			fieldsRecordSet->nextRecord();
-			i++;
+			writer->writeRecord(values);
 		}
 
-		if (m_fields.empty())
+		const RowsAffected rows = writer->finish();
+
+		recordIndex = 0;
+		for (auto recordIterator = recordsBegin; recordIterator != recordsEnd; ++recordIterator, ++recordIndex)
 		{
-			std::string excMessage = "Table " + m_name + " doesn't exist in database.";
-			throw std::runtime_error(excMessage);
+			const unsigned int fieldsValuesCount = (*recordIterator)->getFieldValuesCount();
+			for (unsigned int j = 0; j < fieldsValuesCount; j++)
+			{
+				IFieldValue& fieldValue = (*recordIterator)->getFieldValue(j);
+				if (fieldValue.isDefault())
+				{
+					const IField& field = fieldValue.getField();
+					if (&field == generatedKeyField)
+					{
+						utils::setBigIntValue(fieldValue, generatedKeys[recordIndex]);
+					}
+					else if (!field.isPrimaryKey())
+					{
+						fieldValue.useDefaultValue();
+					}
+				}
+			}
+		}
+
+		return rows;
+	}
+
+	RowsAffected Table::insertBatch(const std::vector<const Field*>& columns,
+									std::vector<ITableRecord*>::const_iterator recordsBegin,
+									std::vector<ITableRecord*>::const_iterator recordsEnd)
+	{
+		const std::size_t recordsCount = std::distance(recordsBegin, recordsEnd);
+		StatementParameters parameters;
+		parameters.reserve(recordsCount * columns.size());
+		SQLBuilder& statementKey = SQLBuilder::getThreadBuilder();
+		statementKey.append("INSERT|").append(m_name).append('|');
+		for (const Field* column : columns)
+		{
+			statementKey.appendNumber(column->getIndex()).append(',');
+		}
+		statementKey.append('x').appendNumber(recordsCount).append('|').append(m_returnedPrimaryKeyName);
+
+		for (auto recordIterator = recordsBegin; recordIterator != recordsEnd; ++recordIterator)
+		{
+			for (const Field* column : columns)
+			{
+				parameters.addFieldValue((*recordIterator)->getFieldValue(column->getIndex()));
+			}
+		}
+
+		const OperationResult operationResult = m_database.executePreparedOperation(statementKey.getText(),
+			[this, &columns, recordsCount]()
+			{
+				SQLBuilder statement(recordsCount * columns.size() * 8);
+				statement.append("INSERT INTO ").append(m_name).append(" (");
+				statement.appendList(columns, ",",
+					[](SQLBuilder& builder, const Field* column)
+					{
+						builder.append(column->getName());
+					});
+
+				statement.append(") VALUES ");
+				for (std::size_t i = 0; i < recordsCount; i++)
+				{
+					if (i > 0)
+					{
+						statement.append(',');
+					}
+
+					appendValuesRowSQL(statement, columns.size(), i * columns.size() + 1);
+				}
+
+				if (!m_returnedPrimaryKeyName.empty())
+				{
+					statement.append(" RETURNING ").append(m_returnedPrimaryKeyName);
+				}
+
+				return statement.releaseText();
+			},
+			parameters);
+
+		// The rows of a multi-row VALUES list are returned in the same order they are listed
+		const std::vector<std::int64_t>& rowIds = operationResult.returnedKeys;
+		std::size_t recordIndex = 0;
+		for (auto recordIterator = recordsBegin; recordIterator != recordsEnd && recordIndex < rowIds.size(); ++recordIterator, ++recordIndex)
+		{
+			fillInsertedRecord(**recordIterator, rowIds[recordIndex]);
+		}
+
+		return operationResult.rowsAffected;
+	}
+
+	void Table::fillInsertedRecord(ITableRecord& record, std::int64_t rowId) const
+	{
+		const unsigned int fieldsValuesCount = record.getFieldValuesCount();
+		for (unsigned int j = 0; j < fieldsValuesCount; j++)
+		{
+			IFieldValue& fieldValue = record.getFieldValue(j);
+			if (fieldValue.isDefault())
+			{
+				if (fieldValue.getField().isPrimaryKey())
+				{
+					utils::setBigIntValue(fieldValue, rowId);
+				}
+				else
+				{
+					fieldValue.useDefaultValue();
+				}
+			}
+		}
+	}
+
+	std::vector<std::int64_t> Table::reservePrimaryKeys(const IField& primaryKeyField, std::size_t count) const
+	{
+		std::string query = "SELECT nextval(pg_get_serial_sequence(" + utils::getStringLiteral(m_name) + ", " +
+							utils::getStringLiteral(primaryKeyField.getName()) + ")) AS next_key "
+							"FROM generate_series(1, " + std::to_string(count) + ")";
+
+		std::vector<std::int64_t> primaryKeys;
+		std::unique_ptr<IRecordSet> keysRecordSet = m_database.executeQuery(query, ResultFormat::TEXT);
+		while (keysRecordSet->isCurrentRecordValid())
+		{
+			const IFieldValue& keyValue = keysRecordSet->getCurrentRecord().getFieldValue("next_key");
+			if (keyValue.isNull())
+			{
+				throw std::runtime_error("Primary key field " + primaryKeyField.getName() + " has no associated sequence.");
+			}
+
+			primaryKeys.push_back(utils::getBigIntValue(keyValue));
+			keysRecordSet->nextRecord();
 		}
+
+		return primaryKeys;
 	}
 
 	bool Table::isOwned(const systelab::db::IField& field) const
@@ -2,6 +2,9 @@
 
 #include "DbAdapterInterface/ITable.h"
 
+#include "CopyOptions.h"
+#include "RecordSetMode.h"
+
 namespace systelab::db {
 		class IBinaryValue;
 		class IField;
@@ -12,12 +15,15 @@ namespace systelab::db {
 
 namespace systelab::db::postgresql {
 	class Database;
+	class Field;
+	class FieldNameIndex;
+	class PrimaryKey;
 
 	class Table : public ITable
 	{
 	public:
-		Table(Database& database, const std::string& name);
-		~Table() override = default;
+		Table(Database& database, const std::string& name, unsigned int relationOID);
+		~Table() override;
 
 		std::string getName() const override;
 		const IPrimaryKey& getPrimaryKey() const override;
@@ -36,17 +42,26 @@ namespace systelab::db::postgresql {
 
 		std::unique_ptr<IPrimaryKeyValue> createPrimaryKeyValue() const override;
 
+		std::shared_ptr<const FieldNameIndex> getFieldNameIndex() const;
+
 		std::unique_ptr<ITableRecordSet> getAllRecords() const override;
+		std::unique_ptr<ITableRecordSet> getAllRecords(RecordSetMode recordSetMode) const;
 		std::unique_ptr<ITableRecord> getRecordByPrimaryKey(const IPrimaryKeyValue&) const override;
 		std::unique_ptr<ITableRecordSet> filterRecordsByField(const IFieldValue&, const IField* = NULL) const override;
 		std::unique_ptr<ITableRecordSet> filterRecordsByFields(const std::vector<IFieldValue*>&, const IField* = NULL) const override;
 		std::unique_ptr<ITableRecordSet> filterRecordsByCondition(const std::string& condition) const override;
+		// The condition refers to the values as $1, $2... and is prepared once per connection. NULL and default
+		// values can't be bound (std::runtime_error is thrown), NULL must be written as IS NULL in the template
+		std::unique_ptr<ITableRecordSet> filterRecordsByCondition(const std::string& conditionTemplate,
+																  const std::vector<IFieldValue*>& conditionValues) const;
 		int getMaxFieldValueInt(const IField&) const override;
 
 		std::unique_ptr<ITableRecord> createRecord() const override;
 		std::unique_ptr<ITableRecord> copyRecord(const ITableRecord&) const override;
 
 		RowsAffected insertRecord(ITableRecord&) override;
+		RowsAffected insertRecords(const std::vector<ITableRecord*>& records, const CopyOptions& options = {});
+		RowsAffected insertRecordsInBatches(const std::vector<ITableRecord*>& records, unsigned int batchSize = 1000);
 		RowsAffected updateRecord(const ITableRecord&) override;
 		RowsAffected updateRecord(const std::vector<IFieldValue*>& newValues, const IPrimaryKeyValue&) override;
 		RowsAffected deleteRecord(const ITableRecord&) override;
@@ -55,16 +70,33 @@ namespace systelab::db::postgresql {
 		RowsAffected updateRecordsByCondition(const std::vector<IFieldValue*>& newValues, const std::vector<IFieldValue*>& conditionValues) override;
 		RowsAffected deleteRecordsByCondition(const std::vector<IFieldValue*>& conditionValues) override;
 		RowsAffected deleteRecordsByCondition(const std::string& condition) override;
+		// Same template rules as filterRecordsByCondition: NULL must be written as IS NULL instead of bound
+		RowsAffected deleteRecordsByCondition(const std::string& conditionTemplate, const std::vector<IFieldValue*>& conditionValues);
 
 		RowsAffected deleteAllRecords() override;
 
 	private:
 		Database& m_database;
 		const std::string m_name;
-		std::vector<std::unique_ptr<IField>> m_fields;
-		std::unique_ptr<IPrimaryKey> m_primaryKey;
+		std::vector<std::unique_ptr<Field>> m_fields;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::unique_ptr<PrimaryKey> m_primaryKey;
+		std::string m_returnedPrimaryKeyName;
+		// Prepared queries select the loaded fields explicitly, so columns added later by other sessions don't change their result type
+		std::string m_selectFieldsSQL;
 		
-		void loadFields();
+		void loadFields(unsigned int relationOID);
+		std::vector<const Field*> getInsertColumns(const ITableRecord& record, bool includeDefaultPrimaryKey) const;
+		bool hasDefaultPrimaryKey(const ITableRecord& record) const;
+		RowsAffected insertBatch(const std::vector<const Field*>& columns,
+								 std::vector<ITableRecord*>::const_iterator recordsBegin,
+								 std::vector<ITableRecord*>::const_iterator recordsEnd);
+		void fillInsertedRecord(ITableRecord& record, std::int64_t rowId) const;
+		RowsAffected copyRecords(std::vector<ITableRecord*>::const_iterator recordsBegin,
+								 std::vector<ITableRecord*>::const_iterator recordsEnd,
+								 const std::vector<const Field*>& columns,
+								 const CopyOptions& options);
+		std::vector<std::int64_t> reservePrimaryKeys(const IField& primaryKeyField, std::size_t count) const;
 		bool isOwned(const systelab::db::IField& field) const;
 	};
 }
\ No newline at end of file
@@ -5,80 +5,34 @@
 #include "FieldValue.h"
 
 #include "DbAdapterInterface/ITableRecordSet.h"
-#include "PostgresUtils.h"
+#include "ResultDecoder.h"
 
 namespace systelab::db::postgresql {
 
-	TableRecord::TableRecord(ITableRecordSet& recordSet, const PGresult* statementResult, const int rowIndex)
+	TableRecord::TableRecord(ITableRecordSet& recordSet, const PGresult* statementResult, const int rowIndex,
+							 std::shared_ptr<const FieldNameIndex> fieldNameIndex, std::pmr::memory_resource* arena)
 		: m_table(recordSet.getTable())
+		, m_fieldValues(arena != nullptr ? arena : std::pmr::get_default_resource())
+		, m_fieldNameIndex(std::move(fieldNameIndex))
 	{
 		const unsigned int fieldsCount = recordSet.getFieldsCount();
+		m_fieldValues.reserve(fieldsCount);
 		for (unsigned int i = 0; i < fieldsCount; i++)
 		{
-			std::unique_ptr<IFieldValue> fieldValue;
 			const IField& field = recordSet.getField(i);
 			const unsigned int fieldIndex = field.getIndex();
-			if (PQgetisnull(statementResult, rowIndex, fieldIndex) == 1)
-			{
-				fieldValue.reset(new FieldValue(field));
-			}
-			else
-			{
-				const FieldTypes fieldType = field.getType();
-				const std::string value = PQgetvalue(statementResult, rowIndex, fieldIndex);
-				switch(fieldType)
-				{
-					case BOOLEAN:
-					{
-						bool boolValue = utils::isBooleanTrue(value);
-						fieldValue.reset(new FieldValue(field, boolValue));
-					}
-					break;
-
-					case INT:
-					{
-						int intValue = std::stoi(value);
-						fieldValue.reset(new FieldValue(field, intValue));
-					}
-					break;
-
-					case DOUBLE:
-					{
-						double doubleValue = std::stod(value);
-						fieldValue.reset(new FieldValue(field, doubleValue));
-					}
-					break;
-
-					case STRING:
-					{
-						std::string stringValue(value);
-						fieldValue.reset(new FieldValue(field, stringValue));
-					}
-					break;
-
-					case DATETIME:
-					{
-						std::string stringValue(value);
-						fieldValue.reset(new FieldValue(field, utils::stringISOToDateTime(stringValue)));
-					}
-					break;
-
-					case BINARY:
-					default:
-						throw std::runtime_error( "Unknown field type." );
-				}
-			}
-
-			m_fieldValues.push_back(std::move(fieldValue));
+			m_fieldValues.push_back(utils::decodeFieldValue(field, statementResult, rowIndex, fieldIndex, arena));
 		}
 	}
 
 	TableRecord::~TableRecord()
 	{}
 
-	TableRecord::TableRecord(ITable& table, std::vector< std::unique_ptr<IFieldValue> >& fieldValues)
+	TableRecord::TableRecord(ITable& table, std::vector< std::unique_ptr<IFieldValue> >& fieldValues,
+							 std::shared_ptr<const FieldNameIndex> fieldNameIndex)
 		: m_table(table)
-		, m_fieldValues(std::move(fieldValues))
+		, m_fieldValues(std::make_move_iterator(fieldValues.begin()), std::make_move_iterator(fieldValues.end()))
+		, m_fieldNameIndex(std::move(fieldNameIndex))
 	{}
 
 	ITable& TableRecord::getTable() const
@@ -98,36 +52,25 @@ namespace systelab::db::postgresql {
 
 	IFieldValue& TableRecord::getFieldValue(const std::string& fieldName) const
 	{
-		const auto fieldValueIterator = std::ranges::find_if(m_fieldValues,
-			[&fieldName](const std::unique_ptr<IFieldValue>& fieldValue)
-			{
-				return fieldValue->getField().getName() == fieldName;
-			});
-
-		if (fieldValueIterator != m_fieldValues.cend())
+		const auto fieldValueIndex = findFieldValueIndex(fieldName);
+		if (fieldValueIndex)
 		{
-			return **fieldValueIterator;
+			return *m_fieldValues[*fieldValueIndex];
 		}
-		
+
 		throw std::runtime_error( "The requested field value doesn't exist" );
 	}
 
 	bool TableRecord::hasFieldValue(const std::string& fieldName) const
 	{
-		const auto fieldValueIterator = std::ranges::find_if(m_fieldValues,
-			[&fieldName](const std::unique_ptr<IFieldValue>& fieldValue)
-			{
-				return fieldValue->getField().getName() == fieldName;
-			});
-
-		return fieldValueIterator != m_fieldValues.cend();
+		return findFieldValueIndex(fieldName).has_value();
 	}
 
 	std::vector<IFieldValue*> TableRecord::getValuesList() const
 	{
 		std::vector<IFieldValue*> values;
 		std::ranges::for_each(m_fieldValues, 
-			[this, &values](const std::unique_ptr<IFieldValue>& fieldValue)
+			[this, &values](const ArenaPtr<IFieldValue>& fieldValue)
 			{
 				if (!fieldValue->getField().isPrimaryKey())
 				{
@@ -137,4 +80,27 @@ namespace systelab::db::postgresql {
 
 		return values;
 	}
+
+	std::optional<unsigned int> TableRecord::findFieldValueIndex(const std::string& fieldName) const
+	{
+		if (m_fieldNameIndex)
+		{
+			const auto fieldIndex = m_fieldNameIndex->find(fieldName);
+			if (fieldIndex && *fieldIndex < m_fieldValues.size() && m_fieldValues[*fieldIndex]->getField().getIndex() == *fieldIndex)
+			{
+				return fieldIndex;
+			}
+		}
+
+		const unsigned int fieldValuesCount = static_cast<unsigned int>(m_fieldValues.size());
+		for (unsigned int i = 0; i < fieldValuesCount; i++)
+		{
+			if (m_fieldValues[i]->getField().getName() == fieldName)
+			{
+				return i;
+			}
+		}
+
+		return std::nullopt;
+	}
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "DbAdapterInterface/ITableRecord.h"
 
+#include "FieldNameIndex.h"
+#include "RecordArena.h"
+
 namespace systelab { namespace db {
 	class ITableRecordSet;
 }}
@@ -11,8 +14,9 @@ namespace systelab { namespace db { namespace postgresql {
 	class TableRecord : public ITableRecord
 	{
 	public:
-		TableRecord(ITableRecordSet& recordSet, const PGresult* statementResult, const int rowIndex);
-		TableRecord(ITable&, std::vector<std::unique_ptr<IFieldValue>>&);
+		TableRecord(ITableRecordSet& recordSet, const PGresult* statementResult, const int rowIndex,
+					std::shared_ptr<const FieldNameIndex> fieldNameIndex, std::pmr::memory_resource* arena = nullptr);
+		TableRecord(ITable&, std::vector<std::unique_ptr<IFieldValue>>&, std::shared_ptr<const FieldNameIndex> fieldNameIndex = nullptr);
 		~TableRecord() override;
 
 		ITable& getTable() const override;
@@ -27,6 +31,9 @@ namespace systelab { namespace db { namespace postgresql {
 
 	private:
 		ITable& m_table;
-		std::vector<std::unique_ptr<IFieldValue>> m_fieldValues;
+		std::pmr::vector<ArenaPtr<IFieldValue>> m_fieldValues;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+
+		std::optional<unsigned int> findFieldValueIndex(const std::string& fieldName) const;
 	};
 }}}
\ No newline at end of file
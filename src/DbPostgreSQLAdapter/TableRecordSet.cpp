@@ -2,6 +2,7 @@
 #include "TableRecordSet.h"
 
 #include "Field.h"
+#include "LazyTableRecord.h"
 #include "TableRecord.h"
 
 #include "DbAdapterInterface/ITable.h"
@@ -10,11 +11,27 @@ namespace systelab::db::postgresql {
 
 	TableRecordSet::TableRecordSet(ITable& table, const PGresult* statementResult)
 		: m_table(table)
+		, m_fieldNameIndex(FieldNameIndex::getTableIndex(table))
+		, m_arena(getRecordArenaInitialSize(statementResult, sizeof(TableRecord)))
 	{
 		const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult));
+		m_records.reserve(rowsCount);
 		for(unsigned int i = 0; i < rowsCount; i++)
 		{
-			m_records.push_back(std::make_unique<TableRecord>(*this, statementResult, i));
+			m_records.push_back(makeArenaObject<TableRecord>(&m_arena, *this, statementResult, i, m_fieldNameIndex, &m_arena));
+		}
+
+		m_iterator = m_records.begin();
+	}
+
+	TableRecordSet::TableRecordSet(ITable& table, std::shared_ptr<const PGresult> statementResult)
+		: m_table(table)
+		, m_fieldNameIndex(FieldNameIndex::getTableIndex(table))
+	{
+		const unsigned int rowsCount = static_cast<unsigned int>(PQntuples(statementResult.get()));
+		for (unsigned int i = 0; i < rowsCount; i++)
+		{
+			m_records.push_back(std::make_unique<LazyTableRecord>(*this, statementResult, i, m_fieldNameIndex.get()));
 		}
 
 		m_iterator = m_records.begin();
@@ -61,7 +78,7 @@ namespace systelab::db::postgresql {
 			copiedFieldValues.push_back(currentRecord.getFieldValue(i).clone());
 		}
 
-		return std::make_unique<TableRecord>(m_table, copiedFieldValues);
+		return std::make_unique<TableRecord>(m_table, copiedFieldValues, m_fieldNameIndex);
 	}
 
 	bool TableRecordSet::isCurrentRecordValid() const
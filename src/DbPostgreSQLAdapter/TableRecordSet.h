@@ -2,6 +2,9 @@
 
 #include "DbAdapterInterface/ITableRecordSet.h"
 
+#include "FieldNameIndex.h"
+#include "RecordArena.h"
+
 typedef struct pg_result PGresult;
 
 namespace systelab { namespace db {
@@ -16,6 +19,8 @@ namespace systelab { namespace db { namespace postgresql {
 	{
 	public:
 		TableRecordSet(ITable& table, const PGresult* statementResult);
+		// Records keep the result alive and decode each value on first access
+		TableRecordSet(ITable& table, std::shared_ptr<const PGresult> statementResult);
 		~TableRecordSet() override = default;
 
 		ITable& getTable() const override;
@@ -33,7 +38,9 @@ namespace systelab { namespace db { namespace postgresql {
 
 	private:
 		ITable& m_table;
-		std::vector<std::unique_ptr<ITableRecord>> m_records;
-		std::vector< std::unique_ptr<ITableRecord>>::iterator m_iterator;
+		std::shared_ptr<const FieldNameIndex> m_fieldNameIndex;
+		std::pmr::monotonic_buffer_resource m_arena;
+		std::vector<ArenaPtr<ITableRecord>> m_records;
+		std::vector<ArenaPtr<ITableRecord>>::iterator m_iterator;
 	};
 }}}
\ No newline at end of file
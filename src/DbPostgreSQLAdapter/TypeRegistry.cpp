@@ -0,0 +1,435 @@
+#include "stdafx.h"
+#include "TypeRegistry.h"
+
+#include "BinaryValue.h"
+#include "FieldValue.h"
+#include "PostgresUtils.h"
+
+#include "DbAdapterInterface/IFieldValue.h"
+
+namespace systelab::db::postgresql {
+
+	namespace {
+		// PostgreSQL binary dates and timestamps count from 2000-01-01 00:00:00 UTC
+		constexpr std::chrono::sys_days POSTGRES_EPOCH = std::chrono::year{ 2000 } / 1 / 1;
+
+		const std::uint16_t NUMERIC_NEGATIVE = 0x4000;
+		const std::uint16_t NUMERIC_NAN = 0xC000;
+		const std::uint16_t NUMERIC_POSITIVE_INFINITY = 0xD000;
+		const std::uint16_t NUMERIC_NEGATIVE_INFINITY = 0xF000;
+		const char JSONB_VERSION = 1;
+
+		// Binary values are sent by the server in network byte order
+		template<typename T>
+		T readBigEndian(const char* data)
+		{
+			std::make_unsigned_t<T> value = 0;
+			for (std::size_t i = 0; i < sizeof(T); i++)
+			{
+				value = static_cast<std::make_unsigned_t<T>>((value << 8) | static_cast<unsigned char>(data[i]));
+			}
+
+			return static_cast<T>(value);
+		}
+
+		template<typename T>
+		void appendBigEndian(std::string& buffer, T value)
+		{
+			const auto unsignedValue = static_cast<std::make_unsigned_t<T>>(value);
+			for (int shift = static_cast<int>(sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+			{
+				buffer.push_back(static_cast<char>((unsignedValue >> shift) & 0xFF));
+			}
+		}
+
+		template<typename T>
+		void checkBinarySize(std::string_view data)
+		{
+			if (data.size() != sizeof(T))
+			{
+				throw std::runtime_error("Invalid binary value size.");
+			}
+		}
+
+		void appendPaddedNumber(std::string& buffer, unsigned int value, std::size_t width)
+		{
+			char number[16];
+			const auto [numberEnd, error] = std::to_chars(number, number + sizeof(number), value);
+			const std::size_t numberLength = static_cast<std::size_t>(numberEnd - number);
+			buffer.append((numberLength < width) ? (width - numberLength) : 0, '0');
+			buffer.append(number, numberEnd);
+		}
+
+		double parseDoubleValue(std::string_view data)
+		{
+			double value = 0.;
+			const auto [end, error] = std::from_chars(data.data(), data.data() + data.size(), value);
+			if (error != std::errc() || end != data.data() + data.size())
+			{
+				throw std::runtime_error("Invalid floating point value: " + std::string(data));
+			}
+
+			return value;
+		}
+
+		std::chrono::system_clock::time_point parseDateTime(std::string_view data, const char* format)
+		{
+			std::chrono::sys_time<std::chrono::microseconds> dateTime;
+			std::istringstream dateTimeStream{ std::string(data) };
+			dateTimeStream >> std::chrono::parse(format, dateTime);
+			if (dateTimeStream.fail())
+			{
+				throw std::runtime_error("Invalid date value: " + std::string(data));
+			}
+
+			return std::chrono::time_point_cast<std::chrono::system_clock::duration>(dateTime);
+		}
+
+		DecodedValue decodeTextBoolean(std::string_view data, std::string&)
+		{
+			return utils::isBooleanTrue(std::string(data));
+		}
+
+		DecodedValue decodeTextInteger(std::string_view data, std::string&)
+		{
+			return utils::parseBigIntValue(data);
+		}
+
+		DecodedValue decodeTextDouble(std::string_view data, std::string&)
+		{
+			return parseDoubleValue(data);
+		}
+
+		DecodedValue decodeTextString(std::string_view data, std::string&)
+		{
+			return data;
+		}
+
+		DecodedValue decodeTextBytea(std::string_view data, std::string& buffer)
+		{
+			utils::decodeByteaText(data, buffer);
+			return std::string_view(buffer);
+		}
+
+		DecodedValue decodeTextTimestampWithTimeZone(std::string_view data, std::string&)
+		{
+			return utils::stringISOToDateTime(std::string(data));
+		}
+
+		DecodedValue decodeTextTimestamp(std::string_view data, std::string&)
+		{
+			return parseDateTime(data, "%F %T");
+		}
+
+		DecodedValue decodeTextDate(std::string_view data, std::string&)
+		{
+			return parseDateTime(data, "%F");
+		}
+
+		DecodedValue decodeBinaryBoolean(std::string_view data, std::string&)
+		{
+			checkBinarySize<char>(data);
+			return data[0] != 0;
+		}
+
+		template<typename T>
+		DecodedValue decodeBinaryInteger(std::string_view data, std::string&)
+		{
+			checkBinarySize<T>(data);
+			return static_cast<std::int64_t>(readBigEndian<T>(data.data()));
+		}
+
+		// Widens a float4 through its shortest representation, so it matches the value received in text mode
+		DecodedValue decodeBinaryFloat(std::string_view data, std::string&)
+		{
+			checkBinarySize<float>(data);
+			const float floatValue = std::bit_cast<float>(readBigEndian<std::int32_t>(data.data()));
+			char buffer[32];
+			const auto [floatEnd, toError] = std::to_chars(buffer, buffer + sizeof(buffer), floatValue);
+			double doubleValue = floatValue;
+			std::from_chars(buffer, floatEnd, doubleValue);
+			return doubleValue;
+		}
+
+		DecodedValue decodeBinaryDouble(std::string_view data, std::string&)
+		{
+			checkBinarySize<double>(data);
+			return std::bit_cast<double>(readBigEndian<std::int64_t>(data.data()));
+		}
+
+		// Numerics are sent as base 10000 digits; they are rebuilt as decimal text so the result matches text mode
+		DecodedValue decodeBinaryNumeric(std::string_view data, std::string& buffer)
+		{
+			if (data.size() < 8)
+			{
+				throw std::runtime_error("Invalid binary value size.");
+			}
+
+			const int digitsCount = readBigEndian<std::int16_t>(data.data());
+			const int weight = readBigEndian<std::int16_t>(data.data() + 2);
+			const std::uint16_t sign = readBigEndian<std::uint16_t>(data.data() + 4);
+			if (data.size() != 8 + 2 * static_cast<std::size_t>(digitsCount))
+			{
+				throw std::runtime_error("Invalid binary value size.");
+			}
+
+			switch (sign)
+			{
+				case NUMERIC_NAN:
+					return std::numeric_limits<double>::quiet_NaN();
+				case NUMERIC_POSITIVE_INFINITY:
+					return std::numeric_limits<double>::infinity();
+				case NUMERIC_NEGATIVE_INFINITY:
+					return -std::numeric_limits<double>::infinity();
+				default:
+					break;
+			}
+
+			const auto getDigit = [&data, digitsCount](int index) -> unsigned int
+			{
+				return (index >= 0 && index < digitsCount) ? readBigEndian<std::int16_t>(data.data() + 8 + 2 * index) : 0;
+			};
+
+			buffer.clear();
+			if (sign == NUMERIC_NEGATIVE)
+			{
+				buffer.push_back('-');
+			}
+
+			appendPaddedNumber(buffer, (weight < 0) ? 0 : getDigit(0), 1);
+			for (int i = 1; i <= weight; i++)
+			{
+				appendPaddedNumber(buffer, getDigit(i), 4);
+			}
+
+			buffer.push_back('.');
+			for (int i = weight + 1; i < digitsCount; i++)
+			{
+				appendPaddedNumber(buffer, getDigit(i), 4);
+			}
+
+			return parseDoubleValue(buffer);
+		}
+
+		DecodedValue decodeBinaryJsonb(std::string_view data, std::string&)
+		{
+			if (data.empty() || data[0] != JSONB_VERSION)
+			{
+				throw std::runtime_error("Unsupported jsonb binary version.");
+			}
+
+			return data.substr(1);
+		}
+
+		DecodedValue decodeBinaryUuid(std::string_view data, std::string& buffer)
+		{
+			if (data.size() != 16)
+			{
+				throw std::runtime_error("Invalid binary value size.");
+			}
+
+			const char HEX_DIGITS[] = "0123456789abcdef";
+			buffer.clear();
+			for (std::size_t i = 0; i < data.size(); i++)
+			{
+				if (i == 4 || i == 6 || i == 8 || i == 10)
+				{
+					buffer.push_back('-');
+				}
+
+				const auto byte = static_cast<unsigned char>(data[i]);
+				buffer.push_back(HEX_DIGITS[byte >> 4]);
+				buffer.push_back(HEX_DIGITS[byte & 0x0F]);
+			}
+
+			return std::string_view(buffer);
+		}
+
+		DecodedValue decodeBinaryTime(std::string_view data, std::string& buffer)
+		{
+			checkBinarySize<std::int64_t>(data);
+			const std::chrono::hh_mm_ss<std::chrono::microseconds> time{ std::chrono::microseconds{ readBigEndian<std::int64_t>(data.data()) } };
+			buffer.clear();
+			appendPaddedNumber(buffer, static_cast<unsigned int>(time.hours().count()), 2);
+			buffer.push_back(':');
+			appendPaddedNumber(buffer, static_cast<unsigned int>(time.minutes().count()), 2);
+			buffer.push_back(':');
+			appendPaddedNumber(buffer, static_cast<unsigned int>(time.seconds().count()), 2);
+			if (time.subseconds().count() != 0)
+			{
+				// Trailing zeros of the fraction are omitted, as in the text format
+				buffer.push_back('.');
+				appendPaddedNumber(buffer, static_cast<unsigned int>(time.subseconds().count()), 6);
+				buffer.erase(buffer.find_last_not_of('0') + 1);
+			}
+
+			return std::string_view(buffer);
+		}
+
+		DecodedValue decodeBinaryTimestamp(std::string_view data, std::string&)
+		{
+			checkBinarySize<std::int64_t>(data);
+			const auto microseconds = std::chrono::microseconds{ readBigEndian<std::int64_t>(data.data()) };
+			return std::chrono::time_point_cast<std::chrono::system_clock::duration>(POSTGRES_EPOCH + microseconds);
+		}
+
+		DecodedValue decodeBinaryDate(std::string_view data, std::string&)
+		{
+			checkBinarySize<std::int32_t>(data);
+			const auto days = std::chrono::days{ readBigEndian<std::int32_t>(data.data()) };
+			return std::chrono::time_point_cast<std::chrono::system_clock::duration>(POSTGRES_EPOCH + days);
+		}
+
+		void encodeBinaryBoolean(const IFieldValue& value, std::string& buffer)
+		{
+			buffer.push_back(value.getBooleanValue() ? 1 : 0);
+		}
+
+		void encodeBinarySmallInt(const IFieldValue& value, std::string& buffer)
+		{
+			const int intValue = value.getIntValue();
+			if (intValue < std::numeric_limits<std::int16_t>::min() || intValue > std::numeric_limits<std::int16_t>::max())
+			{
+				throw std::out_of_range("Integer value out of range for a smallint column.");
+			}
+
+			appendBigEndian(buffer, static_cast<std::int16_t>(intValue));
+		}
+
+		void encodeBinaryInt(const IFieldValue& value, std::string& buffer)
+		{
+			appendBigEndian(buffer, static_cast<std::int32_t>(value.getIntValue()));
+		}
+
+		void encodeBinaryBigInt(const IFieldValue& value, std::string& buffer)
+		{
+			appendBigEndian(buffer, utils::getBigIntValue(value));
+		}
+
+		void encodeBinaryFloat(const IFieldValue& value, std::string& buffer)
+		{
+			appendBigEndian(buffer, std::bit_cast<std::int32_t>(static_cast<float>(value.getDoubleValue())));
+		}
+
+		void encodeBinaryDouble(const IFieldValue& value, std::string& buffer)
+		{
+			appendBigEndian(buffer, std::bit_cast<std::int64_t>(value.getDoubleValue()));
+		}
+
+		void encodeBinaryString(const IFieldValue& value, std::string& buffer)
+		{
+			buffer += value.getStringValue();
+		}
+
+		void encodeBinaryBytea(const IFieldValue& value, std::string& buffer)
+		{
+			std::string streamedData;
+			buffer += utils::getBinaryData(value.getBinaryValue(), streamedData);
+		}
+
+		void encodeBinaryJsonb(const IFieldValue& value, std::string& buffer)
+		{
+			buffer.push_back(JSONB_VERSION);
+			buffer += value.getStringValue();
+		}
+
+		void encodeBinaryTimestamp(const IFieldValue& value, std::string& buffer)
+		{
+			appendBigEndian(buffer, std::chrono::duration_cast<std::chrono::microseconds>(value.getDateTimeValue() - POSTGRES_EPOCH).count());
+		}
+
+		void encodeBinaryDate(const IFieldValue& value, std::string& buffer)
+		{
+			const auto days = std::chrono::floor<std::chrono::days>(value.getDateTimeValue() - POSTGRES_EPOCH);
+			appendBigEndian(buffer, static_cast<std::int32_t>(days.count()));
+		}
+
+		const TypeHandler STRING_HANDLER = { STRING, decodeTextString, decodeTextString, encodeBinaryString };
+
+		const std::pair<PostgresqlOID, TypeHandler> BUILTIN_HANDLERS[] = {
+			{ PostgresqlOID::boolOID, { BOOLEAN, decodeTextBoolean, decodeBinaryBoolean, encodeBinaryBoolean } },
+			{ PostgresqlOID::bytearrayOID, { BINARY, decodeTextBytea, decodeTextString, encodeBinaryBytea } },
+			{ PostgresqlOID::charOID, STRING_HANDLER },
+			{ PostgresqlOID::nameOID, STRING_HANDLER },
+			{ PostgresqlOID::bigIntOID, { INT, decodeTextInteger, decodeBinaryInteger<std::int64_t>, encodeBinaryBigInt } },
+			{ PostgresqlOID::smallIntIOD, { INT, decodeTextInteger, decodeBinaryInteger<std::int16_t>, encodeBinarySmallInt } },
+			{ PostgresqlOID::intOID, { INT, decodeTextInteger, decodeBinaryInteger<std::int32_t>, encodeBinaryInt } },
+			{ PostgresqlOID::textOID, STRING_HANDLER },
+			{ PostgresqlOID::oidOID, { INT, decodeTextInteger, decodeBinaryInteger<std::uint32_t> } },
+			{ PostgresqlOID::jsonOID, STRING_HANDLER },
+			{ PostgresqlOID::xmlOID, STRING_HANDLER },
+			{ PostgresqlOID::floatOID, { DOUBLE, decodeTextDouble, decodeBinaryFloat, encodeBinaryFloat } },
+			{ PostgresqlOID::doubleOID, { DOUBLE, decodeTextDouble, decodeBinaryDouble, encodeBinaryDouble } },
+			{ PostgresqlOID::bpcharOID, STRING_HANDLER },
+			{ PostgresqlOID::varcharOID, STRING_HANDLER },
+			{ PostgresqlOID::dateOID, { DATETIME, decodeTextDate, decodeBinaryDate, encodeBinaryDate } },
+			{ PostgresqlOID::timeOID, { STRING, decodeTextString, decodeBinaryTime } },
+			{ PostgresqlOID::timestampOID, { DATETIME, decodeTextTimestamp, decodeBinaryTimestamp, encodeBinaryTimestamp } },
+			{ PostgresqlOID::datetimeOID, { DATETIME, decodeTextTimestampWithTimeZone, decodeBinaryTimestamp, encodeBinaryTimestamp } },
+			{ PostgresqlOID::intervalOID, { STRING, decodeTextString } },
+			{ PostgresqlOID::numericOID, { DOUBLE, decodeTextDouble, decodeBinaryNumeric } },
+			{ PostgresqlOID::pidOID, { STRING, decodeTextString } },
+			{ PostgresqlOID::uuidOID, { STRING, decodeTextString, decodeBinaryUuid } },
+			{ PostgresqlOID::jsonbOID, { STRING, decodeTextString, decodeBinaryJsonb, encodeBinaryJsonb } }
+		};
+	}
+
+	TypeRegistry::TypeRegistry()
+	{
+		for (const auto& [oid, handler] : BUILTIN_HANDLERS)
+		{
+			m_flatHandlers[static_cast<unsigned int>(oid)].store(&handler, std::memory_order_relaxed);
+		}
+	}
+
+	TypeRegistry& TypeRegistry::getInstance()
+	{
+		static TypeRegistry instance;
+		return instance;
+	}
+
+	const TypeHandler* TypeRegistry::findHandler(PostgresqlOID oid) const
+	{
+		const auto oidValue = static_cast<unsigned int>(oid);
+		if (oidValue < FLAT_TABLE_SIZE)
+		{
+			return m_flatHandlers[oidValue].load(std::memory_order_acquire);
+		}
+
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		const auto handlerIterator = m_handlers.find(oidValue);
+		return (handlerIterator != m_handlers.cend()) ? handlerIterator->second : nullptr;
+	}
+
+	const TypeHandler& TypeRegistry::getHandler(PostgresqlOID oid) const
+	{
+		const TypeHandler* handler = findHandler(oid);
+		if (handler == nullptr)
+		{
+			throw std::runtime_error("Type OID not supported: " + std::to_string(static_cast<unsigned int>(oid)));
+		}
+
+		return *handler;
+	}
+
+	void TypeRegistry::registerType(PostgresqlOID oid, const TypeHandler& handler)
+	{
+		const auto oidValue = static_cast<unsigned int>(oid);
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		const bool flatOID = (oidValue < FLAT_TABLE_SIZE);
+		if (flatOID ? (m_flatHandlers[oidValue].load(std::memory_order_relaxed) != nullptr) : m_handlers.contains(oidValue))
+		{
+			throw std::runtime_error("Type OID already registered: " + std::to_string(oidValue));
+		}
+
+		const TypeHandler* registeredHandler = &m_registeredHandlers.emplace_back(handler);
+		if (flatOID)
+		{
+			m_flatHandlers[oidValue].store(registeredHandler, std::memory_order_release);
+		}
+		else
+		{
+			m_handlers.emplace(oidValue, registeredHandler);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DbAdapterInterface/Types.h"
+
+#include "DefaultOID.h"
+
+namespace systelab::db {
+	class IFieldValue;
+}
+
+namespace systelab::db::postgresql {
+
+	// Value of a non-null cell in the representation of its field type. Integers are decoded as 64-bit
+	typedef std::variant<bool, std::int64_t, double, std::string_view, std::chrono::system_clock::time_point> DecodedValue;
+
+	// Decodes the cell data sent by the server. Decoders that need to transform a string write it into
+	// the given buffer and return a view of it
+	typedef DecodedValue (*ValueDecoder)(std::string_view data, std::string& buffer);
+	// Appends the binary representation of a non-null value, without its length
+	typedef void (*BinaryEncoder)(const IFieldValue& value, std::string& buffer);
+
+	struct TypeHandler
+	{
+		FieldTypes fieldType;
+		ValueDecoder textDecoder = nullptr;
+		ValueDecoder binaryDecoder = nullptr;
+		BinaryEncoder binaryEncoder = nullptr;
+	};
+
+	// Maps type OIDs to their field type and value codecs. OIDs of built-in types index a flat table that
+	// is read without locking; OIDs of types created in the database, as enums or domains, live in a map
+	class TypeRegistry
+	{
+	public:
+		static TypeRegistry& getInstance();
+
+		// Null when no handler is registered for the OID
+		const TypeHandler* findHandler(PostgresqlOID oid) const;
+		const TypeHandler& getHandler(PostgresqlOID oid) const;
+
+		// Handlers can't be replaced once registered, as record sets may be using them
+		void registerType(PostgresqlOID oid, const TypeHandler& handler);
+
+	private:
+		static constexpr unsigned int FLAT_TABLE_SIZE = 4096;
+
+		std::array<std::atomic<const TypeHandler*>, FLAT_TABLE_SIZE> m_flatHandlers{};
+		std::unordered_map<unsigned int, const TypeHandler*> m_handlers;
+		std::deque<TypeHandler> m_registeredHandlers;
+		mutable std::shared_mutex m_mutex;
+
+		TypeRegistry();
+	};
+}
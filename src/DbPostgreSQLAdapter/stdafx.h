@@ -10,18 +10,53 @@
 
 // STL
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <deque>
 #include <format>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <numeric>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 #include <optional>
 #include <ranges>
+#include <set>
+#include <shared_mutex>
 #include <source_location>
+#include <thread>
+
+// SYSTEM
+#ifdef _WIN32
+#include <winsock2.h>
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 // 3RD PARTY
-#include <libpq-fe.h>
\ No newline at end of file
+#include <libpq-fe.h>
+#include <libpq/libpq-fs.h>
\ No newline at end of file
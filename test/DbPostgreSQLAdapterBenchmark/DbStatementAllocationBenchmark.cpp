@@ -0,0 +1,122 @@
+#include "stdafx.h"
+#include "HeapAllocationCounter.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "Connection.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IFieldValue.h"
+#include "DbAdapterInterface/ITable.h"
+#include "DbAdapterInterface/ITableRecord.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string ALLOCATION_TABLE_NAME = "ALLOCATION_TABLE";
+	static const unsigned int MEASURED_STATEMENTS_COUNT = 200;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Measures the heap allocations and time spent by the adapter on each insert and update
+	 * statement once the statement has been prepared. Results are reported as test properties
+	 * (--gtest_output=xml) instead of being asserted, as they depend on the standard library.
+	 */
+	class DbStatementAllocationBenchmark : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			createTable(*m_db, ALLOCATION_TABLE_NAME, SCHEMA_PREFIX, 0);
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		ITable& getAllocationTable() const
+		{
+			return m_db->getTable(getPrefixedElement(ALLOCATION_TABLE_NAME, SCHEMA_PREFIX));
+		}
+
+		std::vector<std::unique_ptr<ITableRecord>> createRecords(unsigned int count) const
+		{
+			std::vector<std::unique_ptr<ITableRecord>> records;
+			for (unsigned int i = 0; i < count; i++)
+			{
+				std::unique_ptr<ITableRecord> record = getAllocationTable().createRecord();
+				record->getFieldValue("field_int_index").setIntValue(i);
+				record->getFieldValue("field_str_index").setStringValue("STR" + std::to_string(i % 9));
+				records.push_back(std::move(record));
+			}
+
+			return records;
+		}
+
+	protected:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbStatementAllocationBenchmark, benchmarkInsertRecord)
+	{
+		ITable& table = getAllocationTable();
+		std::vector<std::unique_ptr<ITableRecord>> records = createRecords(MEASURED_STATEMENTS_COUNT + 1);
+		table.insertRecord(*records[0]);
+
+		std::size_t allocationsCount = 0;
+		const auto start = std::chrono::steady_clock::now();
+		{
+			HeapAllocationCounter allocationCounter;
+			for (unsigned int i = 1; i <= MEASURED_STATEMENTS_COUNT; i++)
+			{
+				table.insertRecord(*records[i]);
+			}
+			allocationsCount = allocationCounter.getAllocationsCount();
+		}
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+		RecordProperty("allocationsPerInsert", static_cast<int>(allocationsCount / MEASURED_STATEMENTS_COUNT));
+		RecordProperty("microsecondsPerInsert", static_cast<int>(elapsed.count() / MEASURED_STATEMENTS_COUNT));
+	}
+
+	TEST_F(DbStatementAllocationBenchmark, benchmarkUpdateRecord)
+	{
+		ITable& table = getAllocationTable();
+		std::vector<std::unique_ptr<ITableRecord>> records = createRecords(MEASURED_STATEMENTS_COUNT + 1);
+		for (const auto& record : records)
+		{
+			table.insertRecord(*record);
+
+			// Only field_int_index is updated, the remaining values are left untouched
+			std::vector<IFieldValue*> fieldValues = record->getValuesList();
+			for (IFieldValue* fieldValue : fieldValues)
+			{
+				fieldValue->setDefault();
+			}
+			record->getFieldValue("field_int_index").setIntValue(-1);
+		}
+		table.updateRecord(*records[0]);
+
+		std::size_t allocationsCount = 0;
+		const auto start = std::chrono::steady_clock::now();
+		{
+			HeapAllocationCounter allocationCounter;
+			for (unsigned int i = 1; i <= MEASURED_STATEMENTS_COUNT; i++)
+			{
+				table.updateRecord(*records[i]);
+			}
+			allocationsCount = allocationCounter.getAllocationsCount();
+		}
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+		RecordProperty("allocationsPerUpdate", static_cast<int>(allocationsCount / MEASURED_STATEMENTS_COUNT));
+		RecordProperty("microsecondsPerUpdate", static_cast<int>(elapsed.count() / MEASURED_STATEMENTS_COUNT));
+	}
+}
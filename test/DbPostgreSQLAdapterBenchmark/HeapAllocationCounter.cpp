@@ -0,0 +1,52 @@
+#include "stdafx.h"
+#include "HeapAllocationCounter.h"
+
+namespace {
+	std::atomic<bool> heapAllocationsCounted = false;
+	std::atomic<std::size_t> heapAllocationsCount = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	if (heapAllocationsCounted)
+	{
+		heapAllocationsCount++;
+	}
+
+	void* pointer = std::malloc(size > 0 ? size : 1);
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace systelab::db::postgresql::unit_test {
+
+	HeapAllocationCounter::HeapAllocationCounter()
+		: m_initialAllocationsCount(heapAllocationsCount)
+	{
+		heapAllocationsCounted = true;
+	}
+
+	HeapAllocationCounter::~HeapAllocationCounter()
+	{
+		heapAllocationsCounted = false;
+	}
+
+	std::size_t HeapAllocationCounter::getAllocationsCount() const
+	{
+		return heapAllocationsCount - m_initialAllocationsCount;
+	}
+}
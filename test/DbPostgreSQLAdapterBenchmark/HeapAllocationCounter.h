@@ -0,0 +1,17 @@
+#pragma once
+
+namespace systelab::db::postgresql::unit_test {
+
+	// Counts the calls to the global operator new made while alive
+	class HeapAllocationCounter
+	{
+	public:
+		HeapAllocationCounter();
+		~HeapAllocationCounter();
+
+		std::size_t getAllocationsCount() const;
+
+	private:
+		std::size_t m_initialAllocationsCount;
+	};
+}
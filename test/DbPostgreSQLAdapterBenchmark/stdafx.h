@@ -0,0 +1,20 @@
+#pragma once
+
+#define _SILENCE_TR1_NAMESPACE_DEPRECATION_WARNING 1
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std::string_literals;
+
+// GTEST
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
@@ -0,0 +1,127 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "AsyncReactor.h"
+#include "Connection.h"
+#include "Database.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IRecordSet.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string ASYNC_TABLE_NAME = "ASYNC_TABLE";
+	static const int ASYNC_TABLE_NUM_RECORDS = 20;
+	static const int ASYNC_CONNECTIONS_COUNT = 4;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if the asynchronous statements of several connections are executed
+	 * by a single reactor.
+	 */
+	class DbAsyncTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			for (int i = 0; i < ASYNC_CONNECTIONS_COUNT; i++)
+			{
+				m_databases.push_back(Connection().openDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration)));
+			}
+			createTable(*m_databases.front(), ASYNC_TABLE_NAME, SCHEMA_PREFIX, ASYNC_TABLE_NUM_RECORDS);
+		}
+
+		void TearDown() override
+		{
+			m_databases.clear();
+			dropDatabase(defaultDbName);
+		}
+
+		std::string getTableName() const
+		{
+			return getPrefixedElement(ASYNC_TABLE_NAME, SCHEMA_PREFIX);
+		}
+
+	protected:
+		std::vector<std::unique_ptr<Database>> m_databases;
+	};
+
+	TEST_F(DbAsyncTest, testQueriesOnSeveralConnectionsAreExecutedConcurrently)
+	{
+		AsyncReactor reactor;
+		std::vector<std::future<std::unique_ptr<IRecordSet>>> futures;
+		for (auto& database : m_databases)
+		{
+			futures.push_back(database->executeQueryAsync(reactor, "SELECT pg_sleep(0.5), * FROM " + getTableName()));
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		for (auto& future : futures)
+		{
+			ASSERT_EQ(ASYNC_TABLE_NUM_RECORDS, future.get()->getRecordsCount());
+		}
+		ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500 * ASYNC_CONNECTIONS_COUNT));
+	}
+
+	TEST_F(DbAsyncTest, testOperationsOnTheSameConnectionAreExecutedInOrder)
+	{
+		AsyncReactor reactor;
+		Database& database = *m_databases.front();
+		auto updateFuture = database.executeOperationAsync(reactor, "UPDATE " + getTableName() + " SET field_int_index = -1 WHERE id <= 5");
+		auto deleteFuture = database.executeOperationAsync(reactor, "DELETE FROM " + getTableName() + " WHERE field_int_index = -1");
+
+		ASSERT_EQ(5, updateFuture.get());
+		ASSERT_EQ(5, deleteFuture.get());
+		ASSERT_EQ(ASYNC_TABLE_NUM_RECORDS - 5, database.executeQuery("SELECT * FROM " + getTableName())->getRecordsCount());
+	}
+
+	TEST_F(DbAsyncTest, testFailedStatementIsReportedThroughTheFuture)
+	{
+		AsyncReactor reactor;
+		Database& database = *m_databases.front();
+		auto queryFuture = database.executeQueryAsync(reactor, "SELECT * FROM unexisting_table");
+		ASSERT_THROW(queryFuture.get(), std::runtime_error);
+
+		auto operationFuture = database.executeOperationAsync(reactor, "DELETE FROM " + getTableName());
+		ASSERT_EQ(ASYNC_TABLE_NUM_RECORDS, operationFuture.get());
+	}
+
+	TEST_F(DbAsyncTest, testOperationOnLockedConnectionStartsOnceConnectionIsReleased)
+	{
+		AsyncReactor reactor;
+		Database& database = *m_databases.front();
+		database.getSchemaCacheKey();
+
+		std::unique_ptr<IRecordSet> recordset = database.executeQuery("SELECT * FROM " + getTableName(), RecordSetMode::STREAMING);
+		auto deleteFuture = database.executeOperationAsync(reactor, "DELETE FROM " + getTableName());
+		ASSERT_EQ(std::future_status::timeout, deleteFuture.wait_for(std::chrono::milliseconds(100)));
+
+		recordset.reset();
+		ASSERT_EQ(std::future_status::ready, deleteFuture.wait_for(std::chrono::seconds(5)));
+		ASSERT_EQ(ASYNC_TABLE_NUM_RECORDS, deleteFuture.get());
+	}
+
+	TEST_F(DbAsyncTest, testCopyStatementsFailThroughTheFutureAndLeaveConnectionUsable)
+	{
+		AsyncReactor reactor;
+		Database& database = *m_databases.front();
+		auto copyOutFuture = database.executeQueryAsync(reactor, "COPY " + getTableName() + " TO STDOUT");
+		ASSERT_EQ(std::future_status::ready, copyOutFuture.wait_for(std::chrono::seconds(5)));
+		ASSERT_THROW(copyOutFuture.get(), std::runtime_error);
+
+		auto copyInFuture = database.executeOperationAsync(reactor, "COPY " + getTableName() + " FROM STDIN");
+		ASSERT_EQ(std::future_status::ready, copyInFuture.wait_for(std::chrono::seconds(5)));
+		ASSERT_THROW(copyInFuture.get(), std::runtime_error);
+
+		auto operationFuture = database.executeOperationAsync(reactor, "DELETE FROM " + getTableName());
+		ASSERT_EQ(std::future_status::ready, operationFuture.wait_for(std::chrono::seconds(5)));
+		ASSERT_EQ(ASYNC_TABLE_NUM_RECORDS, operationFuture.get());
+		ASSERT_TRUE(database.isConnectionHealthy(true));
+	}
+}
@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "Connection.h"
+#include "Database.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/ITable.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string CONCURRENCY_TABLE_NAME = "CONCURRENCY_TABLE";
+	static const int CONCURRENCY_TABLE_NUM_RECORDS = 20;
+	static const unsigned int THREADS_COUNT = 4;
+	static const unsigned int ITERATIONS_COUNT = 200;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if a database connection can be shared by several threads.
+	 */
+	class DbConcurrencyTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			createTable(*m_db, CONCURRENCY_TABLE_NAME, SCHEMA_PREFIX, CONCURRENCY_TABLE_NUM_RECORDS);
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		std::string getTableName() const
+		{
+			return getPrefixedElement(CONCURRENCY_TABLE_NAME, SCHEMA_PREFIX);
+		}
+
+		template<typename ThreadFunction>
+		void runThreads(ThreadFunction threadFunction)
+		{
+			std::vector<std::thread> threads;
+			for (unsigned int i = 0; i < THREADS_COUNT; i++)
+			{
+				threads.emplace_back(threadFunction, i);
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+	public:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbConcurrencyTest, testConcurrentGetTableReturnsTheSameTable)
+	{
+		std::array<std::set<const ITable*>, THREADS_COUNT> threadTables;
+		runThreads([this, &threadTables](unsigned int threadIndex)
+			{
+				for (unsigned int i = 0; i < ITERATIONS_COUNT; i++)
+				{
+					threadTables[threadIndex].insert(&m_db->getTable(getTableName()));
+				}
+			});
+
+		const ITable* table = &m_db->getTable(getTableName());
+		for (const auto& tables : threadTables)
+		{
+			ASSERT_EQ(std::set<const ITable*>{ table }, tables);
+		}
+	}
+
+	TEST_F(DbConcurrencyTest, testRowsAffectedByLastChangeOperationIsKeptPerThread)
+	{
+		std::array<unsigned int, THREADS_COUNT> mismatchesCount = {};
+		runThreads([this, &mismatchesCount](unsigned int threadIndex)
+			{
+				const unsigned int expectedRowsAffected = threadIndex + 1;
+				const std::string operation = "UPDATE " + getTableName() + " SET field_int_no_index = " + std::to_string(threadIndex) +
+											  " WHERE id <= " + std::to_string(expectedRowsAffected);
+				for (unsigned int i = 0; i < ITERATIONS_COUNT; i++)
+				{
+					m_db->executeOperation(operation);
+					if (m_db->getRowsAffectedByLastChangeOperation() != expectedRowsAffected)
+					{
+						mismatchesCount[threadIndex]++;
+					}
+				}
+			});
+
+		for (unsigned int threadMismatchesCount : mismatchesCount)
+		{
+			ASSERT_EQ(0, threadMismatchesCount);
+		}
+	}
+
+	TEST_F(DbConcurrencyTest, testOperationResultIsReturnedToTheCallingThread)
+	{
+		std::array<unsigned int, THREADS_COUNT> mismatchesCount = {};
+		runThreads([this, &mismatchesCount](unsigned int threadIndex)
+			{
+				const unsigned int expectedRowsAffected = threadIndex + 1;
+				const std::string operation = "SELECT id FROM " + getTableName() + " WHERE id <= " + std::to_string(expectedRowsAffected);
+				for (unsigned int i = 0; i < ITERATIONS_COUNT; i++)
+				{
+					const OperationResult operationResult = static_cast<Database&>(*m_db).executeOperationWithResult(operation);
+					if (operationResult.rowsAffected != expectedRowsAffected || operationResult.returnedKeys.size() != expectedRowsAffected)
+					{
+						mismatchesCount[threadIndex]++;
+					}
+				}
+			});
+
+		for (unsigned int threadMismatchesCount : mismatchesCount)
+		{
+			ASSERT_EQ(0, threadMismatchesCount);
+		}
+	}
+
+	TEST_F(DbConcurrencyTest, testLastOperationIsNotInheritedFromOtherDatabases)
+	{
+		m_db->executeOperation("UPDATE " + getTableName() + " SET field_int_no_index = 1");
+		ASSERT_EQ(CONCURRENCY_TABLE_NUM_RECORDS, m_db->getRowsAffectedByLastChangeOperation());
+
+		m_db.reset();
+		m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		ASSERT_EQ(0, m_db->getRowsAffectedByLastChangeOperation());
+	}
+}
@@ -0,0 +1,209 @@
+#include "stdafx.h"
+
+#include "ConnectionConfiguration.h"
+#include "ConnectionPool.h"
+#include "Connection.h"
+#include "Database.h"
+#include "DbAdapterInterface/IFieldValue.h"
+#include "DbAdapterInterface/IRecord.h"
+#include "DbAdapterInterface/IRecordSet.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+
+using namespace testing;
+using namespace std::chrono_literals;
+namespace systelab::db::postgresql::unit_test {
+
+	class DbConnectionPoolTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+		}
+
+		void TearDown() override
+		{
+			dropDatabase(defaultDbName);
+		}
+
+		ConnectionPoolConfiguration getPoolConfiguration(unsigned int minSize, unsigned int maxSize) const
+		{
+			ConnectionPoolConfiguration poolConfiguration;
+			poolConfiguration.minSize = minSize;
+			poolConfiguration.maxSize = maxSize;
+			poolConfiguration.checkoutTimeout = 100ms;
+			return poolConfiguration;
+		}
+	};
+
+	TEST_F(DbConnectionPoolTest, testPoolPreOpensMinimumConnections)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(2, 4));
+
+		const auto statistics = pool.getStatistics();
+		ASSERT_EQ(2, statistics.totalConnections);
+		ASSERT_EQ(2, statistics.idleConnections);
+		ASSERT_EQ(0, statistics.leasedConnections);
+	}
+
+	TEST_F(DbConnectionPoolTest, testLeasedDatabaseIsReturnedToPoolWhenReleased)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		{
+			ConnectionPool::Lease lease = pool.acquire();
+			ASSERT_EQ(1, lease->executeQuery("SELECT 1 AS value")->getRecordsCount());
+			ASSERT_EQ(1, pool.getStatistics().leasedConnections);
+		}
+
+		ConnectionPool::Lease lease = pool.acquire();
+		const auto statistics = pool.getStatistics();
+		ASSERT_EQ(1, statistics.totalConnections);
+		ASSERT_EQ(2, statistics.checkouts);
+	}
+
+	TEST_F(DbConnectionPoolTest, testAcquireThrowsWhenNoConnectionIsReleasedBeforeTimeout)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		ConnectionPool::Lease lease = pool.acquire();
+
+		ASSERT_THROW(pool.acquire(), ConnectionPool::CheckoutTimeoutException);
+		ASSERT_EQ(1, pool.getStatistics().timeouts);
+	}
+
+	TEST_F(DbConnectionPoolTest, testPendingTransactionIsRolledBackWhenLeaseIsReleased)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		{
+			ConnectionPool::Lease lease = pool.acquire();
+			lease->executeOperation("CREATE TABLE public.\"POOL_TABLE\" (ID INT PRIMARY KEY)");
+			lease->executeOperation("BEGIN TRANSACTION");
+			lease->executeOperation("INSERT INTO public.\"POOL_TABLE\" (ID) VALUES (1)");
+		}
+
+		ConnectionPool::Lease lease = pool.acquire();
+		ASSERT_EQ(0, lease->executeQuery("SELECT * FROM public.\"POOL_TABLE\"")->getRecordsCount());
+	}
+
+	TEST_F(DbConnectionPoolTest, testResultFormatIsResetWhenLeaseIsReleased)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		{
+			ConnectionPool::Lease lease = pool.acquire();
+			lease->setResultFormat(ResultFormat::BINARY);
+		}
+
+		ConnectionPool::Lease lease = pool.acquire();
+		ASSERT_EQ(ResultFormat::TEXT, lease->getResultFormat());
+	}
+
+	TEST_F(DbConnectionPoolTest, testIdleConnectionsAboveMinimumSizeAreReaped)
+	{
+		ConnectionPoolConfiguration poolConfiguration = getPoolConfiguration(1, 3);
+		poolConfiguration.idleTimeout = 50ms;
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), poolConfiguration);
+		{
+			ConnectionPool::Lease lease1 = pool.acquire();
+			ConnectionPool::Lease lease2 = pool.acquire();
+			ConnectionPool::Lease lease3 = pool.acquire();
+		}
+		ASSERT_EQ(3, pool.getStatistics().idleConnections);
+
+		std::this_thread::sleep_for(100ms);
+		pool.reapIdleConnections();
+
+		const auto statistics = pool.getStatistics();
+		ASSERT_EQ(1, statistics.totalConnections);
+		ASSERT_EQ(1, statistics.idleConnections);
+	}
+
+	TEST_F(DbConnectionPoolTest, testIdleConnectionsAreNotReapedBeforeIdleTimeout)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(0, 2));
+		{
+			ConnectionPool::Lease lease1 = pool.acquire();
+			ConnectionPool::Lease lease2 = pool.acquire();
+		}
+
+		pool.reapIdleConnections();
+		ASSERT_EQ(2, pool.getStatistics().totalConnections);
+	}
+
+	TEST_F(DbConnectionPoolTest, testTerminatedConnectionIsDiscardedWhenValidatedOnCheckout)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		int backendPID = 0;
+		{
+			ConnectionPool::Lease lease = pool.acquire();
+			auto recordset = lease->executeQuery("SELECT pg_backend_pid() AS pid");
+			backendPID = recordset->getCurrentRecord().getFieldValue(0).getIntValue();
+		}
+
+		auto otherDb = Connection().openDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		otherDb->executeQuery("SELECT pg_terminate_backend(" + std::to_string(backendPID) + ", 5000)");
+
+		ConnectionPool::Lease lease = pool.acquire();
+		ASSERT_EQ(1, lease->executeQuery("SELECT 1 AS value")->getRecordsCount());
+
+		const auto statistics = pool.getStatistics();
+		ASSERT_EQ(1, statistics.discardedConnections);
+		ASSERT_EQ(1, statistics.totalConnections);
+	}
+
+	TEST_F(DbConnectionPoolTest, testCheckoutLatencyHistogramCountsEveryCheckout)
+	{
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), getPoolConfiguration(1, 1));
+		for (unsigned int i = 0; i < 5; i++)
+		{
+			ConnectionPool::Lease lease = pool.acquire();
+		}
+
+		const auto statistics = pool.getStatistics();
+		ASSERT_EQ(5, statistics.checkouts);
+		ASSERT_EQ(7, statistics.checkoutLatencyHistogram.size());
+		ASSERT_EQ(std::chrono::microseconds::max(), statistics.checkoutLatencyHistogram.back().upperBound);
+
+		unsigned long long histogramCount = 0;
+		for (std::size_t i = 0; i < statistics.checkoutLatencyHistogram.size(); i++)
+		{
+			histogramCount += statistics.checkoutLatencyHistogram[i].count;
+			if (i > 0)
+			{
+				ASSERT_LT(statistics.checkoutLatencyHistogram[i - 1].upperBound, statistics.checkoutLatencyHistogram[i].upperBound);
+			}
+		}
+		ASSERT_EQ(statistics.checkouts, histogramCount);
+	}
+
+	TEST_F(DbConnectionPoolTest, testConcurrentCheckoutsNeverExceedMaximumSize)
+	{
+		ConnectionPoolConfiguration poolConfiguration = getPoolConfiguration(0, 3);
+		poolConfiguration.checkoutTimeout = 10s;
+		ConnectionPool pool(const_cast<ConnectionConfiguration&>(defaultConfiguration), poolConfiguration);
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			threads.emplace_back([&pool]()
+				{
+					for (unsigned int j = 0; j < 10; j++)
+					{
+						ConnectionPool::Lease lease = pool.acquire();
+						EXPECT_EQ(1, lease->executeQuery("SELECT 1 AS value")->getRecordsCount());
+					}
+				});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		const auto statistics = pool.getStatistics();
+		ASSERT_LE(statistics.totalConnections, 3);
+		ASSERT_EQ(80, statistics.checkouts);
+		ASSERT_EQ(0, statistics.waitingRequests);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "Connection.h"
 #include "ConnectionConfiguration.h"
+#include "Table.h"
 #include "DbAdapterInterface/IDatabase.h"
 #include "DbAdapterInterface/IFieldValue.h"
 #include "DbAdapterInterface/IPrimaryKeyValue.h"
@@ -90,4 +91,27 @@ namespace systelab::db::postgresql::unit_test {
 		std::unique_ptr<ITableRecordSet> recordset = table.filterRecordsByFields(conditionValues);
 		ASSERT_EQ(recordset->getRecordsCount(), 0);
 	}
+
+	TEST_F(DbDeleteOperationsTest, testDeleteMultipleRecordsByConditionWithBoundValues)
+	{
+		Table& table = static_cast<Table&>(getDeleteTable());
+		std::unique_ptr<IFieldValue> strIndexValue = table.createFieldValue(table.getField("field_str_index"), std::string("STR0"));
+
+		int expectedAffectedRows = (int) ceil (DELETE_TABLE_NUM_RECORDS / 9.);
+		RowsAffected nRows = table.deleteRecordsByCondition("field_str_index = $1", { strIndexValue.get() });
+		ASSERT_EQ(nRows, expectedAffectedRows);
+
+		nRows = table.deleteRecordsByCondition("field_str_index = $1", { strIndexValue.get() });
+		ASSERT_EQ(nRows, 0);
+	}
+
+	TEST_F(DbDeleteOperationsTest, testDeleteByConditionWithNullBoundValueThrows)
+	{
+		Table& table = static_cast<Table&>(getDeleteTable());
+		std::unique_ptr<IFieldValue> strIndexValue = table.createFieldValue(table.getField("field_str_index"), std::string("STR0"));
+		strIndexValue->setNull();
+
+		ASSERT_THROW(table.deleteRecordsByCondition("field_str_index = $1", { strIndexValue.get() }), std::runtime_error);
+		ASSERT_EQ(DELETE_TABLE_NUM_RECORDS, table.getAllRecords()->getRecordsCount());
+	}
 }
\ No newline at end of file
@@ -2,11 +2,19 @@
 #include "Helpers/Helpers.h"
 #include "Helpers/DefaultConnectionConfiguration.h"
 
+#include "BinaryValue.h"
 #include "Connection.h"
 #include "ConnectionConfiguration.h"
+#include "Database.h"
+#include "FieldValue.h"
+#include "Table.h"
 #include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IPrimaryKeyValue.h"
+#include "DbAdapterInterface/IRecord.h"
+#include "DbAdapterInterface/IRecordSet.h"
 #include "DbAdapterInterface/ITable.h"
 #include "DbAdapterInterface/ITableRecord.h"
+#include "DbAdapterInterface/ITableRecordSet.h"
 
 namespace {
 	static const double precision = 1e-10;
@@ -46,6 +54,66 @@ namespace systelab::db::postgresql::unit_test {
 			return m_db->getTable(getPrefixedElement(INSERT_TABLE_NAME, SCHEMA_PREFIX));
 		}
 
+		Database& getDatabase() const
+		{
+			return static_cast<Database&>(*m_db);
+		}
+
+		std::vector<std::unique_ptr<ITableRecord>> createCopyRecords(unsigned int firstId, unsigned int count, bool withId) const
+		{
+			std::vector<std::unique_ptr<ITableRecord>> records;
+			for (unsigned int i = firstId; i < firstId + count; i++)
+			{
+				std::unique_ptr<ITableRecord> record = getInsertTable().createRecord();
+				if (withId)
+				{
+					record->getFieldValue("id").setIntValue(i);
+				}
+				record->getFieldValue("field_int_index").setIntValue(2552 + i);
+				record->getFieldValue("field_int_no_index").setIntValue(140 + i);
+				record->getFieldValue("field_str_index").setStringValue("STR\t" + std::to_string(i));
+				record->getFieldValue("field_str_no_index").setNull();
+				record->getFieldValue("field_real").setDoubleValue(1.25 + i);
+				record->getFieldValue("field_bool").setBooleanValue((i % 2) == 0);
+				record->getFieldValue("field_date").setDateTimeValue(getFieldDateValue(i));
+				records.push_back(std::move(record));
+			}
+
+			return records;
+		}
+
+		std::vector<ITableRecord*> getRecordPointers(const std::vector<std::unique_ptr<ITableRecord>>& records) const
+		{
+			std::vector<ITableRecord*> recordPointers;
+			for (const auto& record : records)
+			{
+				recordPointers.push_back(record.get());
+			}
+
+			return recordPointers;
+		}
+
+		void assertCopiedRecords(unsigned int firstId, unsigned int count)
+		{
+			std::string conditionSQL = "id >= " + std::to_string(firstId);
+			std::unique_ptr<ITableRecordSet> recordset = getInsertTable().filterRecordsByCondition(conditionSQL);
+			ASSERT_EQ(count, recordset->getRecordsCount());
+
+			while (recordset->isCurrentRecordValid())
+			{
+				const ITableRecord& record = recordset->getCurrentRecord();
+				const int id = record.getFieldValue("id").getIntValue();
+				ASSERT_EQ(2552 + id, record.getFieldValue("field_int_index").getIntValue());
+				ASSERT_EQ(140 + id, record.getFieldValue("field_int_no_index").getIntValue());
+				ASSERT_EQ("STR\t" + std::to_string(id), record.getFieldValue("field_str_index").getStringValue());
+				ASSERT_TRUE(record.getFieldValue("field_str_no_index").isNull());
+				ASSERT_NEAR(1.25 + id, record.getFieldValue("field_real").getDoubleValue(), precision);
+				ASSERT_EQ((id % 2) == 0, record.getFieldValue("field_bool").getBooleanValue());
+				ASSERT_EQ(getFieldDateValue(id), record.getFieldValue("field_date").getDateTimeValue());
+				recordset->nextRecord();
+			}
+		}
+
 	private:
 		std::unique_ptr<IDatabase> m_db;
 	};
@@ -101,6 +169,117 @@ namespace systelab::db::postgresql::unit_test {
 		}
 	}
 
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithTextCopy)
+	{
+		const auto records = createCopyRecords(INSERT_TABLE_NUM_RECORDS + 1, 50, true);
+		CopyOptions options;
+		options.format = CopyFormat::TEXT;
+		options.bufferSize = 256;
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecords(getRecordPointers(records), options);
+		ASSERT_EQ(50, nRows);
+		assertCopiedRecords(INSERT_TABLE_NUM_RECORDS + 1, 50);
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithBinaryCopy)
+	{
+		const auto records = createCopyRecords(INSERT_TABLE_NUM_RECORDS + 1, 50, true);
+		CopyOptions options;
+		options.format = CopyFormat::BINARY;
+		options.bufferSize = 256;
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecords(getRecordPointers(records), options);
+		ASSERT_EQ(50, nRows);
+		assertCopiedRecords(INSERT_TABLE_NUM_RECORDS + 1, 50);
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithCopyReturnsGeneratedPrimaryKeys)
+	{
+		auto records = createCopyRecords(0, 5, false);
+		records.back()->getFieldValue("field_int_no_index").setDefault();
+		CopyOptions options;
+		options.returnPrimaryKeys = true;
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecords(getRecordPointers(records), options);
+		ASSERT_EQ(5, nRows);
+
+		for (unsigned int i = 0; i < records.size(); i++)
+		{
+			ASSERT_EQ(INSERT_TABLE_NUM_RECORDS + 1 + i, records[i]->getFieldValue("id").getIntValue());
+		}
+		ASSERT_EQ(2, records.back()->getFieldValue("field_int_no_index").getIntValue());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithCopyMixingExplicitAndGeneratedPrimaryKeys)
+	{
+		auto records = createCopyRecords(0, 4, false);
+		records[1]->getFieldValue("id").setIntValue(1000);
+		records[3]->getFieldValue("id").setIntValue(1001);
+		CopyOptions options;
+		options.returnPrimaryKeys = true;
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecords(getRecordPointers(records), options);
+		ASSERT_EQ(4, nRows);
+
+		const std::vector<int> expectedIds = { INSERT_TABLE_NUM_RECORDS + 1, 1000, INSERT_TABLE_NUM_RECORDS + 2, 1001 };
+		for (unsigned int i = 0; i < records.size(); i++)
+		{
+			ASSERT_EQ(expectedIds[i], records[i]->getFieldValue("id").getIntValue());
+
+			std::unique_ptr<ITableRecordSet> recordset = getInsertTable().filterRecordsByCondition("id = " + std::to_string(expectedIds[i]));
+			ASSERT_EQ(1, recordset->getRecordsCount());
+			ASSERT_EQ(2552 + static_cast<int>(i), recordset->getCurrentRecord().getFieldValue("field_int_index").getIntValue());
+		}
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithCopyIsRolledBackOnDuplicatedKey)
+	{
+		const auto records = createCopyRecords(INSERT_TABLE_NUM_RECORDS, 5, true);
+		ASSERT_THROW(static_cast<Table&>(getInsertTable()).insertRecords(getRecordPointers(records)), std::exception);
+
+		std::unique_ptr<ITableRecordSet> recordset = getInsertTable().getAllRecords();
+		ASSERT_EQ(INSERT_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsInBatchesFillsRecordsWithGeneratedIdentifiersAndDefaultValues)
+	{
+		auto records = createCopyRecords(0, 8, false);
+		for (unsigned int i = 0; i < records.size(); i += 2)
+		{
+			records[i]->getFieldValue("field_int_no_index").setDefault();
+		}
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecordsInBatches(getRecordPointers(records), 3);
+		ASSERT_EQ(8, nRows);
+
+		std::set<int> ids;
+		for (unsigned int i = 0; i < records.size(); i++)
+		{
+			const int id = records[i]->getFieldValue("id").getIntValue();
+			ASSERT_GT(id, INSERT_TABLE_NUM_RECORDS);
+			ids.insert(id);
+
+			const int expectedIntNoIndex = ((i % 2) == 0) ? 2 : static_cast<int>(140 + i);
+			ASSERT_EQ(expectedIntNoIndex, records[i]->getFieldValue("field_int_no_index").getIntValue());
+
+			std::unique_ptr<IPrimaryKeyValue> primaryKeyValue = getInsertTable().createPrimaryKeyValue();
+			primaryKeyValue->getFieldValue("id").setIntValue(id);
+			std::unique_ptr<ITableRecord> storedRecord = getInsertTable().getRecordByPrimaryKey(*primaryKeyValue);
+			ASSERT_THAT(storedRecord, NotNull());
+			ASSERT_EQ(static_cast<int>(2552 + i), storedRecord->getFieldValue("field_int_index").getIntValue());
+		}
+		ASSERT_EQ(records.size(), ids.size());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsInBatchesSplitsBatchesExceedingParametersLimit)
+	{
+		const auto records = createCopyRecords(INSERT_TABLE_NUM_RECORDS + 1, 10000, true);
+
+		RowsAffected nRows = static_cast<Table&>(getInsertTable()).insertRecordsInBatches(getRecordPointers(records), 10000);
+		ASSERT_EQ(10000, nRows);
+		assertCopiedRecords(INSERT_TABLE_NUM_RECORDS + 1, 10000);
+	}
+
 	TEST_F(DbInsertOperationsTest, testInsertRecordThrowsAnExceptionIfRecordAlreadyExists)
 	{
 		// Create the record to insert
@@ -147,6 +326,152 @@ namespace systelab::db::postgresql::unit_test {
 		ASSERT_EQ(expectedDateTime, record->getFieldValue("field_date").getDateTimeValue());
 	}
 
+	TEST_F(DbInsertOperationsTest, testExecuteOperationWithResultReturnsInsertedKeysAndCommandTag)
+	{
+		const std::string operation = "INSERT INTO " + getPrefixedElement(INSERT_TABLE_NAME, SCHEMA_PREFIX) + " (field_int_index) "
+									  "VALUES (1), (2) RETURNING id";
+
+		OperationResult operationResult = getDatabase().executeOperationWithResult(operation);
+		ASSERT_EQ(2, operationResult.rowsAffected);
+		ASSERT_EQ(std::vector<std::int64_t>({ INSERT_TABLE_NUM_RECORDS + 1, INSERT_TABLE_NUM_RECORDS + 2 }), operationResult.returnedKeys);
+		ASSERT_EQ("INSERT 0 2", operationResult.commandTag);
+		ASSERT_GT(operationResult.duration.count(), 0);
+	}
+
+	TEST_F(DbInsertOperationsTest, testExecuteOperationWithResultReturningNonIntegerOrNullColumnHasNoKeys)
+	{
+		const std::string tableName = getPrefixedElement(INSERT_TABLE_NAME, SCHEMA_PREFIX);
+
+		OperationResult textResult = getDatabase().executeOperationWithResult("UPDATE " + tableName + " SET field_str_index = 'UPDATED' "
+																			 "WHERE id <= 2 RETURNING field_str_index");
+		ASSERT_EQ(2, textResult.rowsAffected);
+		ASSERT_TRUE(textResult.returnedKeys.empty());
+		ASSERT_EQ("UPDATE 2", textResult.commandTag);
+		ASSERT_EQ(2, getDatabase().getRowsAffectedByLastChangeOperation());
+
+		OperationResult nullResult = getDatabase().executeOperationWithResult("INSERT INTO " + tableName + " (field_int_index) "
+																			 "VALUES (NULL) RETURNING field_int_index");
+		ASSERT_EQ(1, nullResult.rowsAffected);
+		ASSERT_TRUE(nullResult.returnedKeys.empty());
+		ASSERT_EQ("INSERT 0 1", nullResult.commandTag);
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsFillsBigIntGeneratedIdentifiersBeyondIntRange)
+	{
+		const std::string tableName = getPrefixedElement("BIGINT_TABLE", SCHEMA_PREFIX);
+		getDatabase().executeOperation("CREATE TABLE " + tableName + " "
+									   "(ID BIGINT GENERATED BY DEFAULT AS IDENTITY (START WITH 3000000000) PRIMARY KEY, FIELD_INT INT)");
+		Table& table = static_cast<Table&>(getDatabase().getTable(tableName));
+
+		std::unique_ptr<ITableRecord> record = table.createRecord();
+		record->getFieldValue("field_int").setIntValue(1);
+		ASSERT_EQ(1, table.insertRecord(*record));
+		ASSERT_EQ(3000000000, static_cast<FieldValue&>(record->getFieldValue("id")).getBigIntValue());
+		ASSERT_THROW(record->getFieldValue("id").getIntValue(), std::runtime_error);
+
+		std::vector<std::unique_ptr<ITableRecord>> records;
+		for (int i = 0; i < 5; i++)
+		{
+			records.push_back(table.createRecord());
+			records.back()->getFieldValue("field_int").setIntValue(i);
+		}
+
+		ASSERT_EQ(5, table.insertRecordsInBatches(getRecordPointers(records), 2));
+		for (unsigned int i = 0; i < records.size(); i++)
+		{
+			ASSERT_EQ(3000000001 + i, static_cast<FieldValue&>(records[i]->getFieldValue("id")).getBigIntValue());
+		}
+
+		std::unique_ptr<IRecordSet> recordSet = getDatabase().executeQuery("SELECT MAX(id) AS max_id FROM " + tableName);
+		ASSERT_EQ(3000000005, utils::getBigIntValue(recordSet->getCurrentRecord().getFieldValue("max_id")));
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertAndUpdateRecordKeepFullDoublePrecision)
+	{
+		const std::string tableName = getPrefixedElement("DOUBLE_TABLE", SCHEMA_PREFIX);
+		getDatabase().executeOperation("CREATE TABLE " + tableName + " (ID SERIAL PRIMARY KEY, FIELD_DOUBLE DOUBLE PRECISION)");
+		ITable& table = getDatabase().getTable(tableName);
+
+		const double insertedValue = 0.1 + 0.2;
+		std::unique_ptr<ITableRecord> record = table.createRecord();
+		record->getFieldValue("field_double").setDoubleValue(insertedValue);
+		ASSERT_EQ(1, table.insertRecord(*record));
+		ASSERT_EQ(insertedValue, table.getAllRecords()->getCurrentRecord().getFieldValue("field_double").getDoubleValue());
+
+		const double updatedValue = 123456.78901234567;
+		record->getFieldValue("field_double").setDoubleValue(updatedValue);
+		ASSERT_EQ(1, table.updateRecord(*record));
+		ASSERT_EQ(updatedValue, table.getAllRecords()->getCurrentRecord().getFieldValue("field_double").getDoubleValue());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordIntoTableWithoutPrimaryKey)
+	{
+		const std::string tableName = getPrefixedElement("NO_PRIMARY_KEY_TABLE", SCHEMA_PREFIX);
+		getDatabase().executeOperation("CREATE TABLE " + tableName + " (FIELD_INT INT DEFAULT 7, FIELD_STR TEXT)");
+		ITable& table = getDatabase().getTable(tableName);
+
+		std::unique_ptr<ITableRecord> record = table.createRecord();
+		record->getFieldValue("field_str").setStringValue("value");
+		ASSERT_EQ(1, table.insertRecord(*record));
+
+		std::unique_ptr<ITableRecord> defaultRecord = table.createRecord();
+		ASSERT_EQ(1, table.insertRecord(*defaultRecord));
+
+		std::vector<std::unique_ptr<ITableRecord>> records;
+		records.push_back(table.createRecord());
+		records.push_back(table.createRecord());
+		records.back()->getFieldValue("field_int").setIntValue(8);
+		ASSERT_EQ(2, static_cast<Table&>(table).insertRecordsInBatches(getRecordPointers(records), 10));
+
+		ASSERT_EQ(4, table.getAllRecords()->getRecordsCount());
+		ASSERT_EQ(3, table.filterRecordsByCondition("field_int = 7")->getRecordsCount());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordsWithBinaryCopyThrowsWhenSmallIntValueIsOutOfRange)
+	{
+		const std::string tableName = getPrefixedElement("SMALLINT_TABLE", SCHEMA_PREFIX);
+		getDatabase().executeOperation("CREATE TABLE " + tableName + " (ID INT PRIMARY KEY, FIELD_SMALL SMALLINT)");
+		ITable& table = getDatabase().getTable(tableName);
+
+		std::vector<std::unique_ptr<ITableRecord>> records;
+		for (const int value : { 32767, 32768 })
+		{
+			std::unique_ptr<ITableRecord> record = table.createRecord();
+			record->getFieldValue("id").setIntValue(static_cast<int>(records.size()) + 1);
+			record->getFieldValue("field_small").setIntValue(value);
+			records.push_back(std::move(record));
+		}
+
+		CopyOptions options;
+		options.format = CopyFormat::BINARY;
+		ASSERT_THROW(static_cast<Table&>(table).insertRecords(getRecordPointers(records), options), std::out_of_range);
+		ASSERT_EQ(0, table.getAllRecords()->getRecordsCount());
+	}
+
+	TEST_F(DbInsertOperationsTest, testInsertRecordWithBinaryValueIsReadBackInTextAndBinaryResultFormats)
+	{
+		const std::string tableName = getPrefixedElement("BYTEA_TABLE", SCHEMA_PREFIX);
+		getDatabase().executeOperation("CREATE TABLE " + tableName + " "
+									   "(ID SERIAL PRIMARY KEY, FIELD_DATA BYTEA, FIELD_DEFAULT BYTEA DEFAULT '\\x00ff'::bytea)");
+		ITable& table = getDatabase().getTable(tableName);
+
+		const std::string data("\x00\x01" "bytea\0value\xff", 14);
+		std::unique_ptr<ITableRecord> record = table.createRecord();
+		record->getFieldValue("field_data").setBinaryValue(std::make_unique<BinaryValue>(std::string_view(data)));
+		ASSERT_EQ(1, table.insertRecord(*record));
+		ASSERT_EQ(std::string("\0\xff", 2), static_cast<BinaryValue&>(record->getFieldValue("field_default").getBinaryValue()).getData());
+
+		for (const ResultFormat resultFormat : { ResultFormat::TEXT, ResultFormat::BINARY })
+		{
+			getDatabase().setResultFormat(resultFormat);
+			std::unique_ptr<ITableRecordSet> recordSet = table.filterRecordsByField(record->getFieldValue("field_data"));
+			ASSERT_EQ(1, recordSet->getRecordsCount());
+
+			std::istream dataStream = recordSet->getCurrentRecord().getFieldValue("field_data").getBinaryValue().getInputStream();
+			ASSERT_EQ(data, std::string(std::istreambuf_iterator<char>(dataStream), std::istreambuf_iterator<char>()));
+		}
+	}
+
 
 	/**
 	* Tests if conncurrent insert operations over different tables performed using the Postgres DB adapter
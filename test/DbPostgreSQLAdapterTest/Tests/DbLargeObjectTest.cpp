@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "Connection.h"
+#include "Database.h"
+#include "LargeObject.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IRecordSet.h"
+#include "DbAdapterInterface/ITransaction.h"
+
+namespace {
+	static const std::size_t LARGE_OBJECT_CHUNK_SIZE = 1024;
+	static const std::size_t LARGE_OBJECT_SIZE = 10 * LARGE_OBJECT_CHUNK_SIZE + 17;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if large objects are streamed from and to the database in chunks.
+	 */
+	class DbLargeObjectTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		Database& getDatabase() const
+		{
+			return static_cast<Database&>(*m_db);
+		}
+
+		std::string createData() const
+		{
+			std::string data(LARGE_OBJECT_SIZE, '\0');
+			for (std::size_t i = 0; i < data.size(); i++)
+			{
+				data[i] = static_cast<char>(i % 251);
+			}
+
+			return data;
+		}
+
+		std::string readData(const LargeObject& largeObject) const
+		{
+			std::istream inputStream = largeObject.getInputStream();
+			return std::string(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+		}
+
+		bool existsLargeObject(unsigned int oid) const
+		{
+			std::unique_ptr<IRecordSet> recordSet = m_db->executeQuery("SELECT oid FROM pg_largeobject_metadata WHERE oid = " + std::to_string(oid));
+			return recordSet->getRecordsCount() == 1;
+		}
+
+	public:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbLargeObjectTest, testLargeObjectWrittenInChunksIsReadBack)
+	{
+		const std::string data = createData();
+		std::unique_ptr<LargeObject> largeObject = getDatabase().createLargeObject(LARGE_OBJECT_CHUNK_SIZE);
+		const unsigned int oid = largeObject->getOID();
+		{
+			std::ostream outputStream = largeObject->getOutputStream();
+			outputStream.write(data.data(), 100);
+			outputStream.write(data.data() + 100, static_cast<std::streamsize>(data.size() - 100));
+		}
+		largeObject->close();
+
+		std::unique_ptr<LargeObject> readLargeObject = getDatabase().openLargeObject(oid, LargeObjectMode::READ, LARGE_OBJECT_CHUNK_SIZE);
+		ASSERT_EQ(static_cast<std::int64_t>(data.size()), readLargeObject->getSize());
+		ASSERT_EQ(data, readData(*readLargeObject));
+		ASSERT_THROW(readLargeObject->getOutputStream(), std::runtime_error);
+		readLargeObject->close();
+
+		getDatabase().unlinkLargeObject(oid);
+		ASSERT_FALSE(existsLargeObject(oid));
+	}
+
+	TEST_F(DbLargeObjectTest, testLargeObjectDestroyedWithoutClosingIsRolledBack)
+	{
+		unsigned int oid = 0;
+		{
+			std::unique_ptr<LargeObject> largeObject = getDatabase().createLargeObject();
+			oid = largeObject->getOID();
+			largeObject->getOutputStream() << "discarded";
+		}
+
+		ASSERT_FALSE(existsLargeObject(oid));
+	}
+
+	TEST_F(DbLargeObjectTest, testLargeObjectJoinsTransactionInProgress)
+	{
+		unsigned int oid = 0;
+		std::unique_ptr<ITransaction> transaction = m_db->startTransaction();
+		{
+			std::unique_ptr<LargeObject> largeObject = getDatabase().createLargeObject();
+			oid = largeObject->getOID();
+			largeObject->getOutputStream() << "attachment";
+			largeObject->close();
+		}
+		ASSERT_TRUE(existsLargeObject(oid));
+
+		transaction->rollback();
+		ASSERT_FALSE(existsLargeObject(oid));
+	}
+}
@@ -0,0 +1,139 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "Connection.h"
+#include "Database.h"
+#include "Pipeline.h"
+#include "StatementParameters.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IRecordSet.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string PIPELINE_TABLE_NAME = "PIPELINE_TABLE";
+	static const int PIPELINE_TABLE_NUM_RECORDS = 20;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if the operations queued on a pipeline are executed and
+	 * their results are reported in order.
+	 */
+	class DbPipelineTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			createTable(*m_db, PIPELINE_TABLE_NAME, SCHEMA_PREFIX, PIPELINE_TABLE_NUM_RECORDS);
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		Database& getDatabase() const
+		{
+			return static_cast<Database&>(*m_db);
+		}
+
+		std::string getTableName() const
+		{
+			return getPrefixedElement(PIPELINE_TABLE_NAME, SCHEMA_PREFIX);
+		}
+
+		int countRecords(const std::string& condition) const
+		{
+			return m_db->executeQuery("SELECT * FROM " + getTableName() + " WHERE " + condition)->getRecordsCount();
+		}
+
+	private:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbPipelineTest, testQueuedOperationsReportRowsAffected)
+	{
+		std::unique_ptr<Pipeline> pipeline = getDatabase().startPipeline();
+		pipeline->addOperation("BEGIN");
+		for (int i = 1; i <= PIPELINE_TABLE_NUM_RECORDS; i++)
+		{
+			StatementParameters parameters;
+			parameters.addText(std::to_string(i));
+			pipeline->addOperation("UPDATE " + getTableName() + " SET field_int_index = -1 WHERE id = $1", parameters);
+		}
+		pipeline->addOperation("UPDATE " + getTableName() + " SET field_int_no_index = -1");
+		pipeline->addOperation("COMMIT");
+
+		const auto results = pipeline->getResults();
+		pipeline.reset();
+
+		ASSERT_EQ(PIPELINE_TABLE_NUM_RECORDS + 3, results.size());
+		for (int i = 1; i <= PIPELINE_TABLE_NUM_RECORDS; i++)
+		{
+			ASSERT_EQ(Pipeline::StatementStatus::SUCCEEDED, results[i].status);
+			ASSERT_EQ(1, results[i].rowsAffected);
+		}
+		ASSERT_EQ(PIPELINE_TABLE_NUM_RECORDS, results[PIPELINE_TABLE_NUM_RECORDS + 1].rowsAffected);
+		ASSERT_EQ(PIPELINE_TABLE_NUM_RECORDS, countRecords("field_int_index = -1 AND field_int_no_index = -1"));
+	}
+
+	TEST_F(DbPipelineTest, testFailedOperationAbortsOperationsUntilNextSyncPoint)
+	{
+		std::unique_ptr<Pipeline> pipeline = getDatabase().startPipeline();
+		pipeline->addOperation("UPDATE " + getTableName() + " SET field_int_index = -1 WHERE id = 1");
+		pipeline->addOperation("UPDATE " + getTableName() + " SET unexisting_field = 0");
+		pipeline->addOperation("UPDATE " + getTableName() + " SET field_int_index = -1 WHERE id = 2");
+		pipeline->addSyncPoint();
+		pipeline->addOperation("UPDATE " + getTableName() + " SET field_int_index = -1 WHERE id = 3");
+
+		const auto results = pipeline->getResults();
+		pipeline.reset();
+
+		ASSERT_EQ(4, results.size());
+		ASSERT_EQ(Pipeline::StatementStatus::SUCCEEDED, results[0].status);
+		ASSERT_EQ(Pipeline::StatementStatus::FAILED, results[1].status);
+		ASSERT_THAT(results[1].errorMessage, HasSubstr("unexisting_field"));
+		ASSERT_EQ(Pipeline::StatementStatus::ABORTED, results[2].status);
+		ASSERT_EQ(Pipeline::StatementStatus::SUCCEEDED, results[3].status);
+		ASSERT_EQ(1, countRecords("field_int_index = -1 AND id = 3"));
+		ASSERT_EQ(0, countRecords("field_int_index = -1 AND id IN (1, 2)"));
+	}
+
+	TEST_F(DbPipelineTest, testResultsAreCollectedWhilePendingStatementsLimitIsReached)
+	{
+		std::unique_ptr<Pipeline> pipeline = getDatabase().startPipeline(4);
+		for (int i = 1; i <= PIPELINE_TABLE_NUM_RECORDS; i++)
+		{
+			pipeline->addOperation("DELETE FROM " + getTableName() + " WHERE id = " + std::to_string(i));
+		}
+
+		const auto results = pipeline->getResults();
+		ASSERT_EQ(PIPELINE_TABLE_NUM_RECORDS, results.size());
+		ASSERT_TRUE(std::ranges::all_of(results, [](const auto& result) { return result.rowsAffected == 1; }));
+
+		pipeline->addOperation("DELETE FROM " + getTableName());
+		ASSERT_EQ(0, pipeline->getResults().at(0).rowsAffected);
+	}
+
+	TEST_F(DbPipelineTest, testPipelineDestroyedWithUnreadResultsLeavesConnectionUsable)
+	{
+		{
+			std::unique_ptr<Pipeline> pipeline = getDatabase().startPipeline();
+			pipeline->addOperation("DELETE FROM " + getTableName() + " WHERE id = 1");
+			pipeline->addSyncPoint();
+			pipeline->addOperation("DELETE FROM " + getTableName() + " WHERE id = 2");
+		}
+
+		ASSERT_TRUE(getDatabase().isConnectionHealthy(true));
+		ASSERT_EQ(0, countRecords("id IN (1, 2)"));
+		ASSERT_EQ(PIPELINE_TABLE_NUM_RECORDS - 2, countRecords("TRUE"));
+	}
+}
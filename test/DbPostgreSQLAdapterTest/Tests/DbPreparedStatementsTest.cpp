@@ -0,0 +1,153 @@
+#include "stdafx.h"
+
+#include "Connection.h"
+#include "Database.h"
+#include "Table.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/ITable.h"
+#include "DbAdapterInterface/ITableRecord.h"
+#include "DbAdapterInterface/ITableRecordSet.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+namespace
+{
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string PREPARED_TABLE_NAME = "PREPARED_TABLE";
+	static const int PREPARED_TABLE_NUM_RECORDS = 10;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if the table operations performed using the Postgres DB adapter reuse
+	 * the prepared statements of the connection.
+	 */
+	class DbPreparedStatementsTest: public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			createTable(*m_db, PREPARED_TABLE_NAME, SCHEMA_PREFIX, PREPARED_TABLE_NUM_RECORDS);
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		Database& getDatabase() const
+		{
+			return static_cast<Database&>(*m_db);
+		}
+
+		ITable& getPreparedTable() const
+		{
+			return m_db->getTable(getPrefixedElement(PREPARED_TABLE_NAME, SCHEMA_PREFIX));
+		}
+
+	private:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbPreparedStatementsTest, testInsertsWithSameShapeArePreparedOnce)
+	{
+		ITable& table = getPreparedTable();
+		const auto initialStatistics = getDatabase().getPreparedStatementCacheStatistics();
+
+		for (unsigned int i = 0; i < 5; i++)
+		{
+			std::unique_ptr<ITableRecord> record = table.createRecord();
+			record->getFieldValue("field_int_index").setIntValue(i);
+			record->getFieldValue("field_str_index").setStringValue("PREPARED" + std::to_string(i));
+			ASSERT_EQ(1, table.insertRecord(*record));
+		}
+
+		const auto statistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(initialStatistics.misses + 1, statistics.misses);
+		ASSERT_EQ(initialStatistics.hits + 4, statistics.hits);
+	}
+
+	TEST_F(DbPreparedStatementsTest, testFilterWithNullConditionUsesDifferentStatement)
+	{
+		ITable& table = getPreparedTable();
+		std::unique_ptr<IFieldValue> conditionValue = table.createFieldValue(table.getField("field_str_index"), std::string("STR1"));
+		ASSERT_EQ(1, table.filterRecordsByField(*conditionValue)->getRecordsCount());
+
+		conditionValue->setNull();
+		ASSERT_EQ(0, table.filterRecordsByField(*conditionValue)->getRecordsCount());
+
+		const auto statistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(0, statistics.hits);
+		ASSERT_EQ(2, statistics.misses);
+	}
+
+	TEST_F(DbPreparedStatementsTest, testLeastRecentlyUsedStatementsAreEvicted)
+	{
+		ITable& table = getPreparedTable();
+		getDatabase().setPreparedStatementCacheCapacity(1);
+
+		std::unique_ptr<IFieldValue> intCondition = table.createFieldValue(table.getField("field_int_index"), 0);
+		std::unique_ptr<IFieldValue> strCondition = table.createFieldValue(table.getField("field_str_index"), std::string("STR0"));
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+		ASSERT_EQ(2, table.filterRecordsByField(*strCondition)->getRecordsCount());
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+
+		const auto statistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(1, statistics.size);
+		ASSERT_EQ(3, statistics.misses);
+		ASSERT_EQ(2, statistics.evictions);
+	}
+
+	TEST_F(DbPreparedStatementsTest, testStatementsArePreparedAgainAfterTableIsAltered)
+	{
+		Table& table = static_cast<Table&>(getPreparedTable());
+		std::unique_ptr<IFieldValue> intCondition = table.createFieldValue(table.getField("field_int_index"), 0);
+		ASSERT_EQ(2, table.filterRecordsByCondition("field_int_index = $1", { intCondition.get() })->getRecordsCount());
+
+		getDatabase().executeOperation("ALTER TABLE " + getPrefixedElement(PREPARED_TABLE_NAME, SCHEMA_PREFIX) + " ADD COLUMN FIELD_EXTRA INT");
+		ASSERT_EQ(2, table.filterRecordsByCondition("field_int_index = $1", { intCondition.get() })->getRecordsCount());
+
+		const auto statistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(2, statistics.misses);
+		ASSERT_EQ(1, statistics.evictions);
+	}
+
+	TEST_F(DbPreparedStatementsTest, testCachedFilterKeepsWorkingAfterAnotherConnectionAddsColumn)
+	{
+		ITable& table = getPreparedTable();
+		std::unique_ptr<IFieldValue> intCondition = table.createFieldValue(table.getField("field_int_index"), 0);
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+
+		auto otherDb = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		otherDb->executeOperation("ALTER TABLE " + getPrefixedElement(PREPARED_TABLE_NAME, SCHEMA_PREFIX) + " ADD COLUMN FIELD_EXTRA INT");
+
+		std::unique_ptr<ITableRecordSet> recordset = table.filterRecordsByField(*intCondition);
+		ASSERT_EQ(2, recordset->getRecordsCount());
+		ASSERT_EQ(0, recordset->getCurrentRecord().getFieldValue("field_int_index").getIntValue());
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+	}
+
+	TEST_F(DbPreparedStatementsTest, testCachedFilterIsPreparedAgainAfterAnotherConnectionChangesColumnType)
+	{
+		ITable& table = getPreparedTable();
+		std::unique_ptr<IFieldValue> intCondition = table.createFieldValue(table.getField("field_int_index"), 0);
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+
+		auto otherDb = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		otherDb->executeOperation("ALTER TABLE " + getPrefixedElement(PREPARED_TABLE_NAME, SCHEMA_PREFIX) + " ALTER COLUMN FIELD_STR_INDEX TYPE VARCHAR(255)");
+
+		const auto initialStatistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(2, table.filterRecordsByField(*intCondition)->getRecordsCount());
+
+		const auto statistics = getDatabase().getPreparedStatementCacheStatistics();
+		ASSERT_EQ(initialStatistics.misses + 1, statistics.misses);
+		ASSERT_EQ(initialStatistics.evictions + 1, statistics.evictions);
+	}
+}
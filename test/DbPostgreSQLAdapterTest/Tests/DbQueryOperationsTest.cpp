@@ -2,9 +2,17 @@
 #include "Helpers/Helpers.h"
 #include "Helpers/DefaultConnectionConfiguration.h"
 
+#include "ColumnarRecordSet.h"
 #include "Connection.h"
+#include "Database.h"
+#include "FieldValue.h"
+#include "Pipeline.h"
+#include "ResultFieldsCache.h"
+#include "Table.h"
 #include "DbAdapterInterface/IDatabase.h"
 #include "DbAdapterInterface/IPrimaryKeyValue.h"
+#include "DbAdapterInterface/IRecord.h"
+#include "DbAdapterInterface/IRecordSet.h"
 #include "DbAdapterInterface/ITable.h"
 #include "DbAdapterInterface/ITableRecord.h"
 #include "DbAdapterInterface/ITableRecordSet.h"
@@ -48,6 +56,16 @@ namespace systelab::db::postgresql::unit_test {
 			return m_db->getTable(getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX));
 		}
 
+		Database& getDatabase() const
+		{
+			return static_cast<Database&>(*m_db);
+		}
+
+		void setResultFormat(ResultFormat resultFormat)
+		{
+			static_cast<Database&>(*m_db).setResultFormat(resultFormat);
+		}
+
 		void assertRecordSet(ITableRecordSet& recordset)
 		{
 			while (recordset.isCurrentRecordValid())
@@ -90,6 +108,187 @@ namespace systelab::db::postgresql::unit_test {
 		assertRecordSet(*recordset);
 	}
 
+	TEST_F(DbQueryOperationsTest, testQueryAllWithBinaryResultFormat)
+	{
+		setResultFormat(ResultFormat::BINARY);
+		std::unique_ptr<ITableRecordSet> recordset = getQueryTable().getAllRecords();
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+		assertRecordSet(*recordset);
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryAllWithStreamingRecordSet)
+	{
+		std::unique_ptr<ITableRecordSet> recordset = static_cast<Table&>(getQueryTable()).getAllRecords(RecordSetMode::STREAMING);
+		assertRecordSet(*recordset);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryAllWithStreamingRecordSetAndBinaryResultFormat)
+	{
+		setResultFormat(ResultFormat::BINARY);
+		std::unique_ptr<ITableRecordSet> recordset = static_cast<Table&>(getQueryTable()).getAllRecords(RecordSetMode::STREAMING);
+		assertRecordSet(*recordset);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+	}
+
+	TEST_F(DbQueryOperationsTest, testStreamingRecordSetDestroyedBeforeLastRecordReleasesConnection)
+	{
+		{
+			std::unique_ptr<ITableRecordSet> recordset = static_cast<Table&>(getQueryTable()).getAllRecords(RecordSetMode::STREAMING);
+			ASSERT_TRUE(recordset->isCurrentRecordValid());
+			recordset->nextRecord();
+			ASSERT_EQ(2, recordset->getRecordsCount());
+		}
+
+		std::unique_ptr<ITableRecordSet> recordset = getQueryTable().getAllRecords();
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+	}
+
+	TEST_F(DbQueryOperationsTest, testStatementsIssuedWhileStreamingThrowUntilStreamIsFinished)
+	{
+		const std::string query = "SELECT id FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX);
+		std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query, RecordSetMode::STREAMING);
+		ASSERT_TRUE(recordset->isCurrentRecordValid());
+		ASSERT_THROW(getDatabase().executeQuery(query), std::runtime_error);
+		ASSERT_THROW(getDatabase().executeOperation("SELECT 1"), std::runtime_error);
+		ASSERT_THROW(getDatabase().executeQuery(query, RecordSetMode::STREAMING), std::runtime_error);
+		ASSERT_THROW(getDatabase().startPipeline(), std::runtime_error);
+
+		while (recordset->isCurrentRecordValid())
+		{
+			recordset->nextRecord();
+		}
+
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, getDatabase().executeQuery(query)->getRecordsCount());
+	}
+
+	TEST_F(DbQueryOperationsTest, testStreamingQueryWithoutRecordsKeepsFields)
+	{
+		const std::string query = "SELECT id, field_str_index FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " WHERE id < 0";
+		std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query, RecordSetMode::STREAMING);
+		ASSERT_FALSE(recordset->isCurrentRecordValid());
+		ASSERT_EQ(0, recordset->getRecordsCount());
+		ASSERT_EQ(2, recordset->getFieldsCount());
+		ASSERT_EQ("field_str_index", recordset->getField(1).getName());
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryAllWithLazyRecordSet)
+	{
+		std::unique_ptr<ITableRecordSet> recordset = static_cast<Table&>(getQueryTable()).getAllRecords(RecordSetMode::LAZY);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+		assertRecordSet(*recordset);
+	}
+
+	TEST_F(DbQueryOperationsTest, testLazyQueryDecodesOnlyRequestedFieldValues)
+	{
+		const std::string query = "SELECT id, field_str_index FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " ORDER BY id";
+		std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query, RecordSetMode::LAZY);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+
+		std::unique_ptr<IRecord> copiedRecord = recordset->copyCurrentRecord();
+		const IRecord& record = recordset->getCurrentRecord();
+		ASSERT_EQ(&record.getFieldValue("id"), &record.getFieldValue(0));
+		ASSERT_EQ(1, record.getFieldValue("id").getIntValue());
+		ASSERT_EQ(getFieldStringIndexValue(0), copiedRecord->getFieldValue("field_str_index").getStringValue());
+		ASSERT_FALSE(record.hasFieldValue("field_int_index"));
+	}
+
+	TEST_F(DbQueryOperationsTest, testCopiedRecordOutlivesRecordSet)
+	{
+		std::unique_ptr<ITableRecord> copiedRecord;
+		{
+			std::unique_ptr<ITableRecordSet> recordset = getQueryTable().getAllRecords();
+			while (recordset->isCurrentRecordValid() && recordset->getCurrentRecord().getFieldValue("id").getIntValue() != 50)
+			{
+				recordset->nextRecord();
+			}
+
+			ASSERT_TRUE(recordset->isCurrentRecordValid());
+			copiedRecord = recordset->copyCurrentRecord();
+		}
+
+		ASSERT_EQ(50, copiedRecord->getFieldValue("id").getIntValue());
+		assertRecord(*copiedRecord);
+	}
+
+	TEST_F(DbQueryOperationsTest, testColumnarQueryExposesTypedColumns)
+	{
+		setResultFormat(ResultFormat::BINARY);
+		const std::string query = "SELECT id, field_str_index, field_real, NULL::integer AS field_null FROM " +
+								  getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " ORDER BY id";
+		std::unique_ptr<ColumnarRecordSet> recordset = getDatabase().executeColumnarQuery(query);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+
+		const std::span<const int> ids = recordset->column<int>(0);
+		const std::span<const std::string_view> stringValues = recordset->column<std::string_view>(1);
+		const std::span<const double> realValues = recordset->column<double>(2);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, static_cast<int>(ids.size()));
+		for (unsigned int i = 0; i < ids.size(); i++)
+		{
+			ASSERT_EQ(static_cast<int>(i) + 1, ids[i]);
+			ASSERT_EQ(getFieldStringIndexValue(i), stringValues[i]);
+			ASSERT_NEAR(getFieldRealValue(i), realValues[i], precision);
+			ASSERT_TRUE(recordset->isNull(3, i));
+		}
+
+		ASSERT_THROW(recordset->column<double>(0), std::runtime_error);
+	}
+
+	TEST_F(DbQueryOperationsTest, testColumnarQueryIteratesRecords)
+	{
+		const std::string query = "SELECT id, field_str_index FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " ORDER BY id";
+		std::unique_ptr<ColumnarRecordSet> recordset = getDatabase().executeColumnarQuery(query);
+
+		int expectedId = 1;
+		while (recordset->isCurrentRecordValid())
+		{
+			const IRecord& record = recordset->getCurrentRecord();
+			ASSERT_EQ(expectedId, record.getFieldValue("id").getIntValue());
+			ASSERT_EQ(getFieldStringIndexValue(expectedId - 1), record.getFieldValue("field_str_index").getStringValue());
+			recordset->nextRecord();
+			expectedId++;
+		}
+
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS + 1, expectedId);
+	}
+
+	TEST_F(DbQueryOperationsTest, testColumnarQueryDecodesBinaryValuesLongerThanTheirWireSize)
+	{
+		const std::string query = "SELECT md5(i::text)::uuid AS field_uuid, "
+								  "time '00:00:00' + i * interval '1 second' + interval '0.123456 second' AS field_time "
+								  "FROM generate_series(1, " + std::to_string(QUERY_TABLE_NUM_RECORDS) + ") AS i ORDER BY i";
+		std::unique_ptr<ColumnarRecordSet> textRecordset = getDatabase().executeColumnarQuery(query);
+		setResultFormat(ResultFormat::BINARY);
+		std::unique_ptr<ColumnarRecordSet> binaryRecordset = getDatabase().executeColumnarQuery(query);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, binaryRecordset->getRecordsCount());
+
+		const std::span<const std::string_view> textUuids = textRecordset->column<std::string_view>(0);
+		const std::span<const std::string_view> textTimes = textRecordset->column<std::string_view>(1);
+		const std::span<const std::string_view> binaryUuids = binaryRecordset->column<std::string_view>(0);
+		const std::span<const std::string_view> binaryTimes = binaryRecordset->column<std::string_view>(1);
+		for (unsigned int i = 0; i < binaryUuids.size(); i++)
+		{
+			ASSERT_EQ(36, binaryUuids[i].size());
+			ASSERT_EQ(textUuids[i], binaryUuids[i]);
+			ASSERT_EQ(textTimes[i], binaryTimes[i]);
+		}
+
+		ASSERT_EQ("00:00:01.123456", binaryTimes[0]);
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryByPrimaryKeyWithBinaryResultFormat)
+	{
+		setResultFormat(ResultFormat::BINARY);
+		ITable& table = getQueryTable();
+		std::unique_ptr<IPrimaryKeyValue> primaryKeyValue = table.createPrimaryKeyValue();
+		primaryKeyValue->getFieldValue("id").setIntValue(27);
+
+		std::unique_ptr<ITableRecord> record = table.getRecordByPrimaryKey(*primaryKeyValue);
+		ASSERT_THAT(record, NotNull());
+		ASSERT_EQ(record->getFieldValue("id").getIntValue(), 27);
+		assertRecord(*record);
+	}
+
 	TEST_F(DbQueryOperationsTest, testQueryByPrimaryKey)
 	{
 		ITable& table = getQueryTable();
@@ -121,6 +320,37 @@ namespace systelab::db::postgresql::unit_test {
 		}
 	}
 
+	TEST_F(DbQueryOperationsTest, testQueryByConditionWithBoundValues)
+	{
+		Table& table = static_cast<Table&>(getQueryTable());
+		std::unique_ptr<IFieldValue> lowerBoundValue = table.createFieldValue(table.getField("field_int_index"), 0);
+		std::unique_ptr<IFieldValue> strValue = table.createFieldValue(table.getField("field_str_index"), std::string("STR0"));
+
+		const std::string conditionTemplate = "field_int_index >= $1 AND field_str_index <> $2";
+		std::unique_ptr<ITableRecordSet> recordset = table.filterRecordsByCondition(conditionTemplate, { lowerBoundValue.get(), strValue.get() });
+		std::unique_ptr<ITableRecordSet> expectedRecordset = table.filterRecordsByCondition("field_int_index >= 0 AND field_str_index <> 'STR0'");
+		ASSERT_EQ(expectedRecordset->getRecordsCount(), recordset->getRecordsCount());
+
+		lowerBoundValue->setIntValue(QUERY_TABLE_NUM_RECORDS);
+		recordset = table.filterRecordsByCondition(conditionTemplate, { lowerBoundValue.get(), strValue.get() });
+		ASSERT_EQ(0, recordset->getRecordsCount());
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryByConditionWithNullOrDefaultBoundValueThrows)
+	{
+		Table& table = static_cast<Table&>(getQueryTable());
+		std::unique_ptr<IFieldValue> conditionValue = table.createFieldValue(table.getField("field_int_index"), 0);
+
+		conditionValue->setNull();
+		ASSERT_THROW(table.filterRecordsByCondition("field_int_index = $1", { conditionValue.get() }), std::runtime_error);
+
+		conditionValue->setDefault();
+		ASSERT_THROW(table.filterRecordsByCondition("field_int_index = $1", { conditionValue.get() }), std::runtime_error);
+
+		std::unique_ptr<ITableRecordSet> recordset = table.filterRecordsByCondition("field_int_index IS NULL");
+		ASSERT_EQ(0, recordset->getRecordsCount());
+	}
+
 	TEST_F(DbQueryOperationsTest, testQueryWhenFieldIntNoIndexIsZero)
 	{
 		ITable& table = getQueryTable();
@@ -236,4 +466,116 @@ namespace systelab::db::postgresql::unit_test {
 			recordset->nextRecord();
 		}
 	}
-}
\ No newline at end of file
+
+	TEST_F(DbQueryOperationsTest, testQueryWithRepeatedColumnNameReturnsFirstColumn)
+	{
+		std::string query = "SELECT 1 AS field_int, 'A' AS field_str, 2 AS field_int";
+		for (RecordSetMode recordSetMode : { RecordSetMode::MATERIALIZED, RecordSetMode::STREAMING, RecordSetMode::LAZY })
+		{
+			std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query, recordSetMode);
+			ASSERT_EQ(0, recordset->getField("field_int").getIndex());
+
+			const IRecord& record = recordset->getCurrentRecord();
+			ASSERT_TRUE(record.hasFieldValue("field_str"));
+			ASSERT_FALSE(record.hasFieldValue("field_missing"));
+			ASSERT_EQ(1, record.getFieldValue("field_int").getIntValue());
+			ASSERT_EQ(1, recordset->copyCurrentRecord()->getFieldValue("field_int").getIntValue());
+		}
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueriesWithSameColumnsShareResultFields)
+	{
+		const std::string query = "SELECT id, field_str_index FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " WHERE id = ";
+		std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query + "1");
+		const auto statisticsBefore = ResultFieldsCache::getInstance().getStatistics();
+
+		std::unique_ptr<IRecord> copiedRecord;
+		{
+			std::unique_ptr<IRecordSet> otherRecordset = getDatabase().executeQuery(query + "2");
+			ASSERT_EQ(&recordset->getField(0), &otherRecordset->getField(0));
+			copiedRecord = otherRecordset->copyCurrentRecord();
+		}
+
+		const auto statisticsAfter = ResultFieldsCache::getInstance().getStatistics();
+		ASSERT_EQ(statisticsBefore.hits + 1, statisticsAfter.hits);
+		ASSERT_EQ(statisticsBefore.misses, statisticsAfter.misses);
+
+		ResultFieldsCache::getInstance().clear();
+		recordset.reset();
+		ASSERT_EQ("id", copiedRecord->getFieldValue(0).getField().getName());
+		ASSERT_EQ(2, copiedRecord->getFieldValue("id").getIntValue());
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryDecodesExtendedTypesInTextAndBinaryResultFormats)
+	{
+		const std::string query = "SELECT 9000000000::bigint AS field_bigint, 1234.5625::numeric AS field_numeric, "
+								  "'2016-02-02'::date AS field_date, '2016-02-02 02:04:05'::timestamp AS field_timestamp, "
+								  "'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid AS field_uuid, '{\"key\": 1}'::jsonb AS field_jsonb";
+		for (ResultFormat resultFormat : { ResultFormat::TEXT, ResultFormat::BINARY })
+		{
+			setResultFormat(resultFormat);
+			std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query);
+			ASSERT_EQ(INT, recordset->getField("field_bigint").getType());
+			ASSERT_EQ(DOUBLE, recordset->getField("field_numeric").getType());
+			ASSERT_EQ(DATETIME, recordset->getField("field_date").getType());
+			ASSERT_EQ(DATETIME, recordset->getField("field_timestamp").getType());
+			ASSERT_EQ(STRING, recordset->getField("field_uuid").getType());
+			ASSERT_EQ(STRING, recordset->getField("field_jsonb").getType());
+
+			const IRecord& record = recordset->getCurrentRecord();
+			ASSERT_EQ(9000000000, utils::getBigIntValue(record.getFieldValue("field_bigint")));
+			ASSERT_NEAR(1234.5625, record.getFieldValue("field_numeric").getDoubleValue(), precision);
+			ASSERT_EQ(std::chrono::sys_days{ 2d / 2 / 2016 }, record.getFieldValue("field_date").getDateTimeValue());
+			ASSERT_EQ(std::chrono::sys_days{ 2d / 2 / 2016 } + 2h + 4min + 5s, record.getFieldValue("field_timestamp").getDateTimeValue());
+			ASSERT_EQ("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11", record.getFieldValue("field_uuid").getStringValue());
+			ASSERT_EQ("{\"key\": 1}", record.getFieldValue("field_jsonb").getStringValue());
+		}
+	}
+
+	TEST_F(DbQueryOperationsTest, testQueryWithUnregisteredTypeThrowsRuntimeError)
+	{
+		ASSERT_THROW(getDatabase().executeQuery("SELECT '10.0.0.1'::inet AS field_inet"), std::runtime_error);
+	}
+
+	TEST_F(DbQueryOperationsTest, testCopyOutStreamsQueryRowsInCsvFormat)
+	{
+		const std::string query = "SELECT id, field_int_index FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX) + " ORDER BY id";
+		std::ostringstream outputStream;
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, getDatabase().copyOut(query, outputStream, CopyFormat::CSV));
+
+		std::istringstream inputStream(outputStream.str());
+		std::string line;
+		for (int i = 0; i < QUERY_TABLE_NUM_RECORDS; i++)
+		{
+			ASSERT_TRUE(std::getline(inputStream, line));
+			ASSERT_EQ(std::to_string(i + 1) + "," + std::to_string(getFieldIntIndexValue(i)), line);
+		}
+		ASSERT_FALSE(std::getline(inputStream, line));
+	}
+
+	TEST_F(DbQueryOperationsTest, testCopyOutHandsBinaryChunksToSink)
+	{
+		const std::string query = "SELECT id FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX);
+		std::string copiedData;
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, getDatabase().copyOut(query,
+			[&copiedData](std::string_view data)
+			{
+				copiedData += data;
+			}, CopyFormat::BINARY));
+
+		ASSERT_EQ(0, copiedData.compare(0, 11, std::string("PGCOPY\n\377\r\n\0", 11)));
+	}
+
+	TEST_F(DbQueryOperationsTest, testCopyOutSinkErrorLeavesConnectionUsable)
+	{
+		const std::string query = "SELECT * FROM " + getPrefixedElement(QUERY_TABLE_NAME, SCHEMA_PREFIX);
+		ASSERT_THROW(getDatabase().copyOut(query,
+			[](std::string_view)
+			{
+				throw std::runtime_error("Sink failure");
+			}, CopyFormat::TEXT), std::runtime_error);
+
+		std::unique_ptr<IRecordSet> recordset = getDatabase().executeQuery(query);
+		ASSERT_EQ(QUERY_TABLE_NUM_RECORDS, recordset->getRecordsCount());
+	}
+}
@@ -0,0 +1,202 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "BinaryValue.h"
+#include "Connection.h"
+#include "FieldValue.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IField.h"
+#include "DbAdapterInterface/ITable.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string MEMORY_TABLE_NAME = "MEMORY_TABLE";
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests the storage of field values, which keep only the value matching the type of their field:
+	 * short strings inline and longer ones on the heap.
+	 */
+	class DbRecordMemoryTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			m_db->executeOperation("CREATE TABLE " + getPrefixedElement(MEMORY_TABLE_NAME, SCHEMA_PREFIX) + " "
+								   "(ID INT PRIMARY KEY, FIELD_INT BIGINT, FIELD_REAL DOUBLE PRECISION, FIELD_STR TEXT, "
+								   "FIELD_DATE TIMESTAMP, FIELD_DATA BYTEA)");
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		std::unique_ptr<FieldValue> createFieldValue(const std::string& fieldName) const
+		{
+			ITable& table = m_db->getTable(getPrefixedElement(MEMORY_TABLE_NAME, SCHEMA_PREFIX));
+			return std::make_unique<FieldValue>(table.getField(fieldName));
+		}
+
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbRecordMemoryTest, testStringValuesAroundTheInlineCapacityAreStoredUnchanged)
+	{
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		for (const std::size_t length : { 0, 1, 15, 16, 17, 255, 256, 4096 })
+		{
+			std::string value(length, 'x');
+			for (std::size_t i = 0; i < length; i++)
+			{
+				value[i] = static_cast<char>('a' + (i % 26));
+			}
+
+			fieldValue->setStringValue(value);
+			ASSERT_FALSE(fieldValue->isNull());
+			ASSERT_EQ(value, fieldValue->getStringValue());
+		}
+	}
+
+	TEST_F(DbRecordMemoryTest, testStringValueWithEmbeddedNullCharactersIsStoredUnchanged)
+	{
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		const std::string shortValue("a\0b", 3);
+		const std::string longValue = std::string("long\0", 5) + std::string(40, 'z');
+
+		fieldValue->setStringValue(shortValue);
+		ASSERT_EQ(shortValue, fieldValue->getStringValue());
+		fieldValue->setStringValue(longValue);
+		ASSERT_EQ(longValue, fieldValue->getStringValue());
+	}
+
+	TEST_F(DbRecordMemoryTest, testStringValueSwitchesBetweenInlineAndHeapStorage)
+	{
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		const std::string shortValue = "short";
+		const std::string longValue(100, 'L');
+
+		fieldValue->setStringValue(longValue);
+		ASSERT_EQ(longValue, fieldValue->getStringValue());
+		fieldValue->setStringValue(shortValue);
+		ASSERT_EQ(shortValue, fieldValue->getStringValue());
+		fieldValue->setStringValue(longValue);
+		ASSERT_EQ(longValue, fieldValue->getStringValue());
+		fieldValue->setStringValue(longValue + longValue);
+		ASSERT_EQ(longValue + longValue, fieldValue->getStringValue());
+	}
+
+	TEST_F(DbRecordMemoryTest, testStringValueSwitchesBetweenValueNullAndDefault)
+	{
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		const std::string longValue(100, 'L');
+
+		fieldValue->setStringValue(longValue);
+		fieldValue->setNull();
+		ASSERT_TRUE(fieldValue->isNull());
+		ASSERT_THROW(fieldValue->getStringValue(), std::runtime_error);
+
+		fieldValue->setStringValue(longValue);
+		fieldValue->setDefault();
+		ASSERT_TRUE(fieldValue->isDefault());
+		ASSERT_FALSE(fieldValue->isNull());
+		ASSERT_THROW(fieldValue->getStringValue(), std::runtime_error);
+
+		fieldValue->setStringValue("inline");
+		ASSERT_FALSE(fieldValue->isDefault());
+		ASSERT_EQ("inline", fieldValue->getStringValue());
+	}
+
+	TEST_F(DbRecordMemoryTest, testCopiedStringValuesDontShareStorage)
+	{
+		for (const std::string& value : { std::string("inline"), std::string(100, 'H') })
+		{
+			std::unique_ptr<FieldValue> source = createFieldValue("field_str");
+			source->setStringValue(value);
+
+			std::unique_ptr<FieldValue> copy = createFieldValue("field_str");
+			copy->setValue(*source);
+			std::unique_ptr<IFieldValue> clone = source->clone();
+
+			source->setStringValue(std::string(200, 'S'));
+			source.reset();
+			ASSERT_EQ(value, copy->getStringValue());
+			ASSERT_EQ(value, clone->getStringValue());
+		}
+	}
+
+	TEST_F(DbRecordMemoryTest, testCopyingNullAndDefaultValuesReplacesTheStoredString)
+	{
+		std::unique_ptr<FieldValue> nullValue = createFieldValue("field_str");
+		std::unique_ptr<FieldValue> defaultValue = createFieldValue("field_str");
+		defaultValue->setDefault();
+
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		fieldValue->setStringValue(std::string(100, 'L'));
+		fieldValue->setValue(*nullValue);
+		ASSERT_TRUE(fieldValue->isNull());
+
+		fieldValue->setStringValue(std::string(100, 'L'));
+		fieldValue->setValue(*defaultValue);
+		ASSERT_TRUE(fieldValue->isDefault());
+	}
+
+	TEST_F(DbRecordMemoryTest, testScalarValuesKeepTheirFullRange)
+	{
+		std::unique_ptr<FieldValue> intValue = createFieldValue("field_int");
+		intValue->setBigIntValue(std::numeric_limits<std::int64_t>::min());
+		ASSERT_EQ(std::numeric_limits<std::int64_t>::min(), intValue->getBigIntValue());
+		ASSERT_THROW(intValue->getIntValue(), std::runtime_error);
+		intValue->setIntValue(-7);
+		ASSERT_EQ(-7, intValue->getIntValue());
+
+		std::unique_ptr<FieldValue> doubleValue = createFieldValue("field_real");
+		doubleValue->setDoubleValue(std::numeric_limits<double>::lowest());
+		ASSERT_EQ(std::numeric_limits<double>::lowest(), doubleValue->getDoubleValue());
+
+		const auto dateTime = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(1234567890123));
+		std::unique_ptr<FieldValue> dateTimeValue = createFieldValue("field_date");
+		dateTimeValue->setDateTimeValue(dateTime);
+		ASSERT_EQ(dateTime, dateTimeValue->getDateTimeValue());
+	}
+
+	TEST_F(DbRecordMemoryTest, testValueOfAnotherTypeIsRejectedAndStoredValueIsKept)
+	{
+		const std::string longValue(100, 'L');
+		std::unique_ptr<FieldValue> fieldValue = createFieldValue("field_str");
+		fieldValue->setStringValue(longValue);
+
+		ASSERT_THROW(fieldValue->setIntValue(1), std::runtime_error);
+		ASSERT_THROW(fieldValue->setDoubleValue(1.5), std::runtime_error);
+		ASSERT_THROW(fieldValue->setBinaryValue(std::make_unique<BinaryValue>(std::string_view("data"))), std::runtime_error);
+		ASSERT_THROW(fieldValue->setValue(*createFieldValue("field_int")), std::runtime_error);
+		ASSERT_THROW(fieldValue->getIntValue(), std::runtime_error);
+		ASSERT_EQ(longValue, fieldValue->getStringValue());
+	}
+
+	TEST_F(DbRecordMemoryTest, testBinaryValueIsOwnedAndCopiedByTheFieldValue)
+	{
+		const std::string data("\x00\x01" "binary\xff", 9);
+		std::unique_ptr<FieldValue> source = createFieldValue("field_data");
+		source->setBinaryValue(std::make_unique<BinaryValue>(std::string_view(data)));
+
+		std::unique_ptr<FieldValue> copy = createFieldValue("field_data");
+		copy->setValue(*source);
+		source->setBinaryValue(std::make_unique<BinaryValue>(std::string_view("other")));
+		source->setNull();
+		source.reset();
+
+		ASSERT_EQ(data, static_cast<BinaryValue&>(copy->getBinaryValue()).getData());
+		copy->setBinaryValue(nullptr);
+		ASSERT_TRUE(copy->isNull());
+	}
+}
@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include "Helpers/Helpers.h"
+#include "Helpers/DefaultConnectionConfiguration.h"
+
+#include "Connection.h"
+#include "Database.h"
+#include "Pipeline.h"
+#include "SchemaCache.h"
+#include "DbAdapterInterface/IDatabase.h"
+#include "DbAdapterInterface/IPrimaryKey.h"
+#include "DbAdapterInterface/IRecordSet.h"
+#include "DbAdapterInterface/ITable.h"
+
+namespace {
+	static const std::string SCHEMA_PREFIX = "public";
+	static const std::string SCHEMA_CACHE_TABLE_NAME = "SCHEMA_CACHE_TABLE";
+	static const std::string SCHEMA_CACHE_OTHER_TABLE_NAME = "SCHEMA_CACHE_OTHER_TABLE";
+	static const std::string SCHEMA_CACHE_OTHER_SCHEMA = "schema_cache_other";
+	static const int SCHEMA_CACHE_TABLE_NUM_RECORDS = 5;
+}
+
+using namespace testing;
+namespace systelab::db::postgresql::unit_test {
+
+	/**
+	 * Tests if the table metadata loaded by a database connection is shared
+	 * with other connections to the same database and dropped after DDL.
+	 */
+	class DbSchemaCacheTest : public Test
+	{
+	protected:
+		void SetUp() override
+		{
+			dropDatabase(defaultDbName);
+			createDatabase(defaultDbName);
+
+			m_db = Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+			createTable(*m_db, SCHEMA_CACHE_TABLE_NAME, SCHEMA_PREFIX, SCHEMA_CACHE_TABLE_NUM_RECORDS);
+		}
+
+		void TearDown() override
+		{
+			m_db.reset();
+			dropDatabase(defaultDbName);
+		}
+
+		std::unique_ptr<IDatabase> openDatabase() const
+		{
+			return Connection().loadDatabase(const_cast<ConnectionConfiguration&>(defaultConfiguration));
+		}
+
+		std::string getTableName() const
+		{
+			return getPrefixedElement(SCHEMA_CACHE_TABLE_NAME, SCHEMA_PREFIX);
+		}
+
+	public:
+		std::unique_ptr<IDatabase> m_db;
+	};
+
+	TEST_F(DbSchemaCacheTest, testSecondDatabaseReusesCachedTableSchema)
+	{
+		const unsigned int fieldsCount = m_db->getTable(getTableName()).getFieldsCount();
+		const auto statisticsBefore = SchemaCache::getInstance().getStatistics();
+
+		auto otherDb = openDatabase();
+		const ITable& table = otherDb->getTable(getTableName());
+
+		const auto statisticsAfter = SchemaCache::getInstance().getStatistics();
+		ASSERT_EQ(fieldsCount, table.getFieldsCount());
+		ASSERT_EQ(statisticsBefore.hits + 1, statisticsAfter.hits);
+		ASSERT_EQ(statisticsBefore.misses, statisticsAfter.misses);
+	}
+
+	TEST_F(DbSchemaCacheTest, testSchemaChangeInvalidatesCachedTableSchema)
+	{
+		const unsigned int fieldsCount = m_db->getTable(getTableName()).getFieldsCount();
+		const std::string schemaCacheKey = static_cast<Database&>(*m_db).getSchemaCacheKey();
+		const auto versionBefore = SchemaCache::getInstance().getVersion(schemaCacheKey);
+
+		auto otherDb = openDatabase();
+		otherDb->executeOperation("ALTER TABLE " + getTableName() + " ADD COLUMN FIELD_EXTRA INT");
+		ASSERT_LT(versionBefore, SchemaCache::getInstance().getVersion(schemaCacheKey));
+
+		auto reloadedDb = openDatabase();
+		const ITable& table = reloadedDb->getTable(getTableName());
+		ASSERT_EQ(fieldsCount + 1, table.getFieldsCount());
+		ASSERT_EQ("field_extra", table.getField(fieldsCount).getName());
+	}
+
+	TEST_F(DbSchemaCacheTest, testSchemaChangeQueuedInPipelineInvalidatesCachedTableSchema)
+	{
+		Database& database = static_cast<Database&>(*m_db);
+		const unsigned int fieldsCount = m_db->getTable(getTableName()).getFieldsCount();
+		const std::string schemaCacheKey = database.getSchemaCacheKey();
+		const auto versionBefore = SchemaCache::getInstance().getVersion(schemaCacheKey);
+
+		std::unique_ptr<Pipeline> pipeline = database.startPipeline();
+		pipeline->addOperation("ALTER TABLE " + getTableName() + " ADD COLUMN FIELD_EXTRA INT");
+		ASSERT_EQ(Pipeline::StatementStatus::SUCCEEDED, pipeline->getResults().at(0).status);
+		pipeline.reset();
+		const auto versionAfterResults = SchemaCache::getInstance().getVersion(schemaCacheKey);
+		ASSERT_LT(versionBefore, versionAfterResults);
+
+		// Results discarded when the pipeline is destroyed are reported as well
+		pipeline = database.startPipeline();
+		pipeline->addOperation("ALTER TABLE " + getTableName() + " ADD COLUMN FIELD_OTHER INT");
+		pipeline.reset();
+		ASSERT_LT(versionAfterResults, SchemaCache::getInstance().getVersion(schemaCacheKey));
+
+		auto reloadedDb = openDatabase();
+		ASSERT_EQ(fieldsCount + 2, reloadedDb->getTable(getTableName()).getFieldsCount());
+	}
+
+	TEST_F(DbSchemaCacheTest, testExplicitInvalidationReloadsTableSchema)
+	{
+		m_db->getTable(getTableName());
+		SchemaCache::getInstance().invalidate();
+		const auto statisticsBefore = SchemaCache::getInstance().getStatistics();
+
+		auto otherDb = openDatabase();
+		otherDb->getTable(getTableName());
+
+		const auto statisticsAfter = SchemaCache::getInstance().getStatistics();
+		ASSERT_EQ(statisticsBefore.misses + 1, statisticsAfter.misses);
+		ASSERT_EQ(1, statisticsAfter.size);
+	}
+
+	TEST_F(DbSchemaCacheTest, testPreloadSchemaBuildsAllTablesFromOneCatalogQuery)
+	{
+		createTable(*m_db, SCHEMA_CACHE_OTHER_TABLE_NAME, SCHEMA_PREFIX, SCHEMA_CACHE_TABLE_NUM_RECORDS);
+		SchemaCache::getInstance().invalidate();
+		const auto statisticsBefore = SchemaCache::getInstance().getStatistics();
+
+		ASSERT_EQ(2, static_cast<Database&>(*m_db).preloadSchema(SCHEMA_PREFIX));
+
+		const ITable& table = m_db->getTable(getTableName());
+		const ITable& otherTable = m_db->getTable(getPrefixedElement(SCHEMA_CACHE_OTHER_TABLE_NAME, SCHEMA_PREFIX));
+		ASSERT_EQ(8, table.getFieldsCount());
+		ASSERT_EQ(8, otherTable.getFieldsCount());
+		ASSERT_EQ(1, table.getPrimaryKey().getFieldsCount());
+		ASSERT_EQ("id", table.getPrimaryKey().getField(0).getName());
+
+		const auto statisticsAfter = SchemaCache::getInstance().getStatistics();
+		ASSERT_EQ(statisticsBefore.misses, statisticsAfter.misses);
+	}
+
+	TEST_F(DbSchemaCacheTest, testPreloadedTableIsFoundByUnqualifiedNameWithoutQueryingTheServer)
+	{
+		m_db->executeOperation("SET search_path TO " + SCHEMA_PREFIX);
+		Database& database = static_cast<Database&>(*m_db);
+		ASSERT_EQ(1, database.preloadSchema(SCHEMA_PREFIX));
+		const ITable& table = m_db->getTable(getTableName());
+
+		// While the connection is streaming any statement would throw, so the table must come from the loaded ones
+		std::unique_ptr<IRecordSet> recordset = database.executeQuery("SELECT * FROM " + getTableName(), RecordSetMode::STREAMING);
+		ASSERT_EQ(&table, &m_db->getTable("\"" + SCHEMA_CACHE_TABLE_NAME + "\""));
+		recordset.reset();
+
+		ASSERT_EQ(&table, &m_db->getTable("\"" + SCHEMA_PREFIX + "\".\"" + SCHEMA_CACHE_TABLE_NAME + "\""));
+	}
+
+	TEST_F(DbSchemaCacheTest, testSameTableNameInAnotherSchemaIsNotReused)
+	{
+		m_db->executeOperation("CREATE SCHEMA " + SCHEMA_CACHE_OTHER_SCHEMA);
+		m_db->executeOperation("CREATE TABLE " + getPrefixedElement(SCHEMA_CACHE_TABLE_NAME, SCHEMA_CACHE_OTHER_SCHEMA) +
+							   " (ID INT GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY, FIELD_OTHER TEXT)");
+		const std::string unqualifiedTableName = "\"" + SCHEMA_CACHE_TABLE_NAME + "\"";
+		m_db->executeOperation("SET search_path TO " + SCHEMA_PREFIX);
+		ASSERT_EQ(8, m_db->getTable(unqualifiedTableName).getFieldsCount());
+
+		auto otherDb = openDatabase();
+		otherDb->executeOperation("SET search_path TO " + SCHEMA_CACHE_OTHER_SCHEMA);
+		const ITable& otherTable = otherDb->getTable(unqualifiedTableName);
+		ASSERT_EQ(2, otherTable.getFieldsCount());
+		ASSERT_EQ("field_other", otherTable.getField(1).getName());
+	}
+}
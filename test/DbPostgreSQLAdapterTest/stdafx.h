@@ -3,12 +3,27 @@
 #define _SILENCE_TR1_NAMESPACE_DEPRECATION_WARNING 1
 
 // STL
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <source_location>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 using namespace std::string_literals;
 
 // GTEST